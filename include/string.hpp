@@ -8,10 +8,58 @@
 
 #include "string_view.hpp"
 #include <algorithm>
+#include <bit>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <utility>
+
+// Whether erasing from a large string moves it back into the small buffer once it fits, releasing its allocation.
+enum class erase_policy : bool
+{
+    keep_allocation,
+    shrink_to_small,
+};
+
+// How a string lays out its state in memory.
+enum class string_layout : std::uint8_t
+{
+    // The small buffer shares its bytes with the pointer to the large buffer, and is followed by the size and capacity.
+    // The small buffer grows until it holds the minimum internal capacity, reclaiming any padding after the size and capacity.
+    standard,
+    // The pointer to the large buffer is followed by the size and capacity, and the small buffer spans all three.
+    // Its last element holds how many elements are unused, so it's the null terminator once they're all used,
+    // and the top bit of the capacity, in the same byte, tells the modes apart. A std::size_t string is 24 bytes,
+    // holding 23 chars inline. Strings are never small when constant evaluated, since that byte can't be read
+    // through whichever member isn't active, and the small buffer doesn't grow past what the fields span.
+    packed,
+    // Like the standard layout, but the size and capacity are a byte each, so a std::size_t string is 24 bytes
+    // holding 21 chars inline, the same as a std::uint8_t one. Once the capacity needs more than a byte, it's set to
+    // a sentinel and the size and capacity spill into a header before the elements, in the same allocation.
+    spill,
+};
+
+// Describes how a string type lays out its state in memory, to compare the memory and cache use of different parameters.
+// Offsets and sizes are in bytes.
+struct string_layout_info
+{
+    string_layout layout;          // How the string lays out its state.
+    std::size_t size;              // The size of the string object.
+    std::size_t alignment;         // The alignment of the string object.
+    std::size_t sboc;              // The number of characters the small buffer holds, excluding the null terminator.
+    std::size_t max_length;        // The longest string the size type can describe. The allocator may limit it further.
+    std::size_t buffer_offset;     // The offset of the small buffer, which shares its bytes with the pointer to the large buffer.
+    std::size_t buffer_size;       // The size of the small buffer, including the null terminator.
+    std::size_t size_offset;       // The offset of the size.
+    std::size_t capacity_offset;   // The offset of the capacity.
+    std::size_t field_size;        // The size of the size and of the capacity.
+    std::size_t padding;           // The number of bytes that hold nothing.
+
+    // Returns how many strings fit in a cache line of the given size, when stored contiguously.
+    [[nodiscard]] constexpr std::size_t per_cache_line(std::size_t cache_line_size = 64) const noexcept { return cache_line_size / size; }
+};
 
 template
 <
@@ -19,7 +67,8 @@ template
     typename _size_t = std::size_t,
     _size_t _min_internal_capacity = 15 / sizeof(_char_t),
     typename _traits_t = std::char_traits<_char_t>,
-    typename _allocator_t = STRING_DEFAULT_ALLOCATOR
+    typename _allocator_t = STRING_DEFAULT_ALLOCATOR,
+    string_layout _layout = string_layout::standard
 >
 class basic_string
 {
@@ -50,47 +99,49 @@ public:
     static_assert(std::is_same_v<value_type, typename allocator_type::value_type>, "Allocator must have same value type.");
     static_assert(std::is_nothrow_default_constructible_v<allocator_type>, "Allocator must be nothrow default constructible.");
     static_assert(std::is_empty_v<allocator_type>, "Allocator must be stateless.");
+    static_assert(_layout != string_layout::packed || (sizeof(pointer) + 2 * sizeof(size_type)) % alignof(pointer) == 0,
+        "The packed layout needs the size and capacity to fill whole pointers, so the capacity ends the string.");
+    static_assert(_layout != string_layout::packed || std::endian::native == std::endian::little,
+        "The packed layout needs the top byte of the capacity to be the last byte of the string.");
 
 public:
     [[nodiscard]] constexpr basic_string() noexcept
-        : _size(0)
     {
         _init_small();
         _eos();
     }
 
     [[nodiscard]] constexpr basic_string(const basic_string& string)
-        : _size(string._size)
     {
-        _init_from_size();
-        traits_type::copy(_elements(), string._elements(), _size);
+        _init_from_size(string.size());
+        traits_type::copy(_elements(), string._elements(), string.size());
     }
 
     [[nodiscard]] constexpr basic_string(basic_string&& string) noexcept
-        : _size(string._size)
     {
-        if (_size <= _internal_capacity())
+        size_type string_size = string.size();
+        if (string_size <= _internal_capacity())
         {
             _init_small();
+            traits_type::copy(_elements(), string._elements(), string_size);
+            _set_size(string_size);
             _eos();
-            traits_type::copy(_small_buffer, string._small_buffer, _size);
         }
         else
         {
             _init_large();
-            _large_buffer = string._large_buffer;
-            _capacity = string._capacity;
-            string._become_small();
+            _set_allocation(string._current_allocation());
+            _set_size(string_size);
+            string._become_small(0);
         }
-        string._size = 0;
+        string._set_size(0);
         string._eos();
     }
 
     [[nodiscard]] explicit constexpr basic_string(string_view_type view)
-        : _size(view.size())
     {
-        _init_from_size();
-        traits_type::copy(_elements(), view.data(), _size);
+        _init_from_size(view.size());
+        traits_type::copy(_elements(), view.data(), view.size());
     }
 
     [[nodiscard]] constexpr basic_string(const_pointer elements)
@@ -100,9 +151,8 @@ public:
     }
 
     [[nodiscard]] constexpr basic_string(size_type count, value_type element) noexcept
-        : _size(count)
     {
-        _init_from_size();
+        _init_from_size(count);
         traits_type::assign(_elements(), count, element);
     }
 
@@ -112,14 +162,15 @@ public:
     {
         if (this != std::addressof(string))
         {
-            _size = string._size;
-            if (_capacity < _size)
+            size_type string_size = string.size();
+            if (capacity() < string_size)
             {
                 _become_large_or_deallocate();
-                _allocate_current();
+                _set_allocation(_allocate(string_size));
             }
+            _set_size(string_size);
             _eos();
-            traits_type::copy(_elements(), string._elements(), _size);
+            traits_type::copy(_elements(), string._elements(), string_size);
         }
         return *this;
     }
@@ -128,25 +179,26 @@ public:
     {
         if (this != std::addressof(string))
         {
-            _size = string._size;
-            if (_capacity < _size)
+            size_type string_size = string.size();
+            if (capacity() < string_size)
             {
                 _become_large_or_deallocate();
-                _large_buffer = string._large_buffer;
-                _capacity = string._capacity;
-                string._become_small();
+                _set_allocation(string._current_allocation());
+                _set_size(string_size);
+                string._become_small(0);
             }
             else // does not imply anything about string.small()
             {
+                _set_size(string_size);
                 _eos();
-                traits_type::copy(_elements(), string._elements(), _size);
+                traits_type::copy(_elements(), string._elements(), string_size);
                 if (!string.small())
                 {
                     string._deallocate_current();
-                    string._become_small();
+                    string._become_small(0);
                 }
             }
-            string._size = 0;
+            string._set_size(0);
             string._eos();
         }
         return *this;
@@ -156,21 +208,21 @@ public:
     {
         if (_elements() != view.data())
         {
-            _size = view.size();
-            if (_capacity < _size)
+            if (capacity() < view.size())
             {
                 _become_large_or_deallocate();
-                _allocate_current();
-                traits_type::copy(_large_buffer, view.data(), _size);
+                _set_allocation(_allocate(view.size()));
+                traits_type::copy(_elements(), view.data(), view.size());
             }
             else
-                traits_type::move(_elements(), view.data(), _size);
+                traits_type::move(_elements(), view.data(), view.size());
+            _set_size(view.size());
             _eos();
         }
-        else if (_size > view.size())
+        else if (size() > view.size())
         {
             // view is substr(0, view.size()), so just set the size and null terminator.
-            _size = view.size();
+            _set_size(view.size());
             _eos();
         }
         return *this;
@@ -196,13 +248,13 @@ public:
 
     constexpr basic_string& assign(size_type count, value_type element)
     {
-        _size = count;
-        if (_capacity < _size)
+        if (capacity() < count)
         {
             _become_large_or_deallocate();
-            _allocate_current();
+            _set_allocation(_allocate(count));
         }
         traits_type::assign(_elements(), count, element);
+        _set_size(count);
         _eos();
         return *this;
     }
@@ -215,7 +267,7 @@ public:
 
     // Returns an immutable reference to the character at the given index in the string.
     [[nodiscard]] constexpr const_reference at(size_type index) const
-    { return 0 <= index && index < _size ? _elements()[index] : nult; }
+    { return 0 <= index && index < size() ? _elements()[index] : nult; }
     // Returns a reference to the character at the given index in the string.
     [[nodiscard]] constexpr reference at(size_type index)
     { return const_cast<reference>(const_cast<const basic_string*>(this)->at(index)); }
@@ -226,9 +278,9 @@ public:
     [[nodiscard]] constexpr const_reference front() const { return at(0); }
 
     // Returns a reference to the last character in the string.
-    [[nodiscard]] constexpr reference back() { return at(_size - 1); }
+    [[nodiscard]] constexpr reference back() { return at(size() - 1); }
     // Returns an immutable reference to the last character in the string.
-    [[nodiscard]] constexpr const_reference back() const { return at(_size - 1); }
+    [[nodiscard]] constexpr const_reference back() const { return at(size() - 1); }
 
     // Returns a pointer to the elements.
     [[nodiscard]] constexpr pointer data() noexcept { return _elements(); }
@@ -239,25 +291,51 @@ public:
     [[nodiscard]] constexpr const_pointer c_str() const noexcept { return _elements(); }
 
     // Converts this string into a string view.
-    [[nodiscard]] constexpr operator string_view_type() const noexcept { return {_elements(), _size}; }
+    [[nodiscard]] constexpr operator string_view_type() const noexcept { return {_elements(), size()}; }
 
 public:
     // Returns if the string is currently in small mode.
-    [[nodiscard]] constexpr bool small() const noexcept { return _capacity <= _internal_capacity(); }
+    [[nodiscard]] constexpr bool small() const noexcept
+    {
+        if constexpr (_layout == string_layout::packed)
+        {
+            if consteval
+            {
+                return false;
+            }
+            else
+            {
+                // The top bit of the last element is the top bit of a large string's capacity, which marks it large.
+                // Reading it through the small buffer lets the compiler see it was written by _set_unused.
+                constexpr int top_bit = 8 * sizeof(value_type) - 1;
+                return (static_cast<std::make_unsigned_t<value_type>>(_small_buffer[_internal_capacity()]) >> top_bit) == 0;
+            }
+        }
+        else
+            return _fields.capacity <= _internal_capacity();
+    }
 
     // Returns if the string is empty.
-    [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
 
     // Returns the length of the string.
-    [[nodiscard]] constexpr size_type size() const noexcept { return _size; }
+    [[nodiscard]] constexpr size_type size() const noexcept
+    {
+        if constexpr (_layout == string_layout::packed)
+            return small() ? static_cast<size_type>(_internal_capacity() - _unused()) : _large.size;
+        else if constexpr (_layout == string_layout::spill)
+            return _fields.capacity != _spilled ? _fields.size : _spill_header_field(0);
+        else
+            return _fields.size;
+    }
 
     // Returns the signed length of the string.
-    [[nodiscard]] constexpr ssize_type ssize() const noexcept { return static_cast<ssize_type>(_size); }
+    [[nodiscard]] constexpr ssize_type ssize() const noexcept { return static_cast<ssize_type>(size()); }
 
     // Returns the length of the string.
-    [[nodiscard]] constexpr size_type length() const noexcept { return _size; }
+    [[nodiscard]] constexpr size_type length() const noexcept { return size(); }
 
-    // Returns the max size of the string.
+    // Returns the max size of the string. Sizes are kept signed, so it's under half the range of the size type.
     [[nodiscard]] constexpr size_type max_size() const noexcept
     {
         return std::min(
@@ -266,48 +344,59 @@ public:
         );
     }
 
-    // Ensures the allocated capacity is at least `new_capacity`.
+    // Ensures the allocated capacity is at least `new_capacity`. Nothing is reserved past `max_size()`.
     constexpr void reserve(size_type new_capacity)
     {
-        if (_capacity < new_capacity)
+        if (capacity() < new_capacity && new_capacity <= max_size())
         {
             auto allocation = _allocate(new_capacity);
-            traits_type::copy(allocation.elements, _elements(), _size);
-
-            if (small())
-                _become_large();
-            else
-                _deallocate_current();
-
-            _large_buffer = allocation.elements;
-            _capacity = allocation.capacity;
+            traits_type::copy(allocation.elements, _elements(), size());
+            _adopt(allocation);
             _eos();
         }
     }
 
+    // Ensures the allocated capacity is at least `count`, clamped to `max_size()`, then lets `operation(data(), count)`
+    // write the elements. The size becomes what it returns, which must be at most `count`.
+    template <typename _operation_t>
+    constexpr void resize_and_overwrite(size_type count, _operation_t operation)
+    {
+        count = std::min(count, max_size());
+        reserve(count);
+        _set_size(static_cast<size_type>(std::move(operation)(_elements(), count)));
+        _eos();
+    }
+
     // Returns the capacity of the string.
-    [[nodiscard]] constexpr size_type capacity() const noexcept { return _capacity; }
+    [[nodiscard]] constexpr size_type capacity() const noexcept
+    {
+        if constexpr (_layout == string_layout::packed)
+            return small() ? _internal_capacity() : _large_capacity();
+        else if constexpr (_layout == string_layout::spill)
+            return _fields.capacity != _spilled ? _fields.capacity : _spill_header_field(1);
+        else
+            return _fields.capacity;
+    }
 
     // Sets capacity equal to size, if possible.
     // Capacity will never be less than `sboc`.
     constexpr void shrink_to_fit()
     {
-        if (!small() && _size != _capacity)
+        size_type old_size = size();
+        if (!small() && old_size != _large_capacity())
         {
-            if (_size <= _internal_capacity())
+            if (old_size <= _internal_capacity())
             {
                 auto old_allocation = _current_allocation();
-                _become_small();
-                traits_type::copy(_small_buffer, old_allocation.elements, _size);
+                _become_small(old_size);
+                traits_type::copy(_elements(), old_allocation.elements, old_size);
                 _deallocate(old_allocation);
             }
             else
             {
-                auto allocation = _allocate(_size);
-                traits_type::copy(allocation.elements, _large_buffer, _size);
-                _deallocate_current();
-                _large_buffer = allocation.elements;
-                _capacity = allocation.capacity;
+                auto allocation = _allocate(old_size);
+                traits_type::copy(allocation.elements, _large.elements, old_size);
+                _adopt(allocation);
             }
             _eos();
         }
@@ -317,13 +406,118 @@ public:
     // Makes the string empty, but keeps its current allocation, if any.
     constexpr void clear() noexcept
     {
-        _size = 0;
+        _set_size(0);
+        _eos();
+    }
+
+    // Removes the leading characters that are in the given set, moving the rest to the front.
+    constexpr basic_string& trim_left(string_view_type set = string_view_type::whitespace()) noexcept
+    {
+        size_type count = std::min(find_first_not_of(set), size());
+        if (count != 0)
+        {
+            size_type new_size = static_cast<size_type>(size() - count);
+            traits_type::move(_elements(), _elements() + count, new_size);
+            _set_size(new_size);
+            _eos();
+        }
+        return *this;
+    }
+
+    // Removes the trailing characters that are in the given set, which never moves the rest.
+    constexpr basic_string& trim_right(string_view_type set = string_view_type::whitespace()) noexcept
+    {
+        _set_size(static_cast<size_type>(find_last_not_of(set) + 1));
+        _eos();
+        return *this;
+    }
+
+    // Removes the leading and trailing characters that are in the given set.
+    constexpr basic_string& trim(string_view_type set = string_view_type::whitespace()) noexcept
+    {
+        // Trimming the right first leaves less to move.
+        trim_right(set);
+        return trim_left(set);
+    }
+
+    // Inserts the view before `position`, which is clamped to the string.
+    // The rest of the string is moved once, within the spare capacity if there's enough.
+    constexpr basic_string& insert(size_type position, string_view_type view) { return replace(position, 0, view); }
+
+    // Inserts `count` copies of the character before `position`, which is clamped to the string.
+    constexpr basic_string& insert(size_type position, size_type count, value_type element)
+    {
+        _splice(std::min(position, size()), 0, count, [count, element](pointer elements) { traits_type::assign(elements, count, element); });
+        return *this;
+    }
+
+    // Erases `count` characters starting at `position`. Both are clamped to the string.
+    // The allocation is kept, unless the policy says to move the string back into the small buffer once it fits.
+    constexpr basic_string& erase(size_type position, size_type count = npos, erase_policy policy = erase_policy::keep_allocation) noexcept
+    {
+        position = std::min(position, size());
+        count = std::min<size_type>(count, size() - position);
+        size_type new_size = static_cast<size_type>(size() - count);
+        size_type tail = static_cast<size_type>(new_size - position);
+        if (policy == erase_policy::shrink_to_small && !small() && new_size <= _internal_capacity())
+        {
+            // Copy straight into the small buffer, rather than moving the tail first.
+            auto old_allocation = _current_allocation();
+            _become_small(new_size);
+            traits_type::copy(_elements(), old_allocation.elements, position);
+            traits_type::copy(_elements() + position, old_allocation.elements + position + count, tail);
+            _deallocate(old_allocation);
+        }
+        else
+        {
+            traits_type::move(_elements() + position, _elements() + position + count, tail);
+            _set_size(new_size);
+        }
         _eos();
+        return *this;
     }
 
-    // TODO: insert
+    // Erases every character for which `predicate(character)` is true, in a single pass, and returns how many there were.
+    // The allocation is kept, unless the policy says to move the string back into the small buffer once it fits.
+    template <typename _predicate_t>
+    constexpr size_type erase_if(_predicate_t predicate, erase_policy policy = erase_policy::keep_allocation)
+    {
+        pointer elements = _elements();
+        size_type old_size = size();
+        size_type kept = static_cast<size_type>(std::find_if(elements, elements + old_size, predicate) - elements);
+        // Compact the rest without branching on each character, always storing it and only keeping it if it's not erased.
+        for (size_type i = kept; i < old_size; ++i)
+        {
+            value_type element = elements[i];
+            elements[kept] = element;
+            kept += !predicate(element);
+        }
+        return _erase_to(kept, policy);
+    }
 
-    // TODO: erase
+    // Erases every character that is in the given set, and returns how many there were.
+    // The characters to erase are found a vector block at a time, and the runs between them are moved as a whole.
+    // The allocation is kept, unless the policy says to move the string back into the small buffer once it fits.
+    constexpr size_type erase_any(string_view_type set, erase_policy policy = erase_policy::keep_allocation)
+    {
+        // A set in the elements would be overwritten by compacting them, so copy it first.
+        basic_string copy;
+        if (_overlaps(set))
+            set = copy.assign(set);
+        pointer elements = _elements();
+        string_view_type view(*this);
+        size_type kept = view.find_first_of(set);
+        if (kept == npos)
+            return 0;
+        for (size_type run = kept; (run = view.find_first_not_of(set, run)) != npos; )
+        {
+            size_type run_end = std::min(view.find_first_of(set, run), view.size());
+            traits_type::move(elements + kept, elements + run, run_end - run);
+            kept += run_end - run;
+            run = run_end;
+        }
+        return _erase_to(kept, policy);
+    }
 
     // TODO: push_back
 
@@ -333,7 +527,31 @@ public:
 
     // TODO: operator+=
 
-    // TODO: replace
+    // Replaces `count` characters starting at `position` with the view. Both are clamped to the string.
+    // The string only reallocates if the result doesn't fit its capacity, and nothing is replaced if it wouldn't fit in the string.
+    constexpr basic_string& replace(size_type position, size_type count, string_view_type view)
+    {
+        position = std::min(position, size());
+        count = std::min<size_type>(count, size() - position);
+
+        // A view into the elements could be moved out from under itself, so copy it first.
+        basic_string copy;
+        if (size() - count + std::size_t(view.size()) <= capacity() && _overlaps(view))
+            view = copy.assign(view);
+        _splice(position, count, view.size(), [view](pointer elements) { traits_type::copy(elements, view.data(), view.size()); });
+        return *this;
+    }
+
+    // Replaces every occurrence of the needle with the replacement, scanning from the front, and returns how many there were.
+    // If the string grows, the occurrences are counted first so it reallocates at most once, to the exact size.
+    // Either way, the rest of the string is shifted in a single pass. Nothing is replaced if the result wouldn't fit in the string.
+    constexpr size_type replace_all(string_view_type needle, string_view_type replacement)
+    {
+        if (_overlaps(needle) || _overlaps(replacement))
+            return basic_string(*this)._replace_all_into(*this, basic_string(needle), basic_string(replacement));
+        return _replace_all_into(*this, needle, replacement);
+    }
+
 
     // TODO: resize
 
@@ -342,25 +560,27 @@ public:
     {
         if (small())
         {
+            size_type this_size = size();
+            size_type other_size = string.size();
             if (string.small())
             {
                 value_type temp[_internal_capacity()];
-                traits_type::copy(temp, _small_buffer, _size);
-                traits_type::copy(_small_buffer, string._small_buffer, string._size);
-                traits_type::copy(string._small_buffer, temp, _size);
-                std::swap(_size, string._size);
+                traits_type::copy(temp, _small_buffer, this_size);
+                traits_type::copy(_small_buffer, string._small_buffer, other_size);
+                traits_type::copy(string._small_buffer, temp, this_size);
+                _set_size(other_size);
+                string._set_size(this_size);
                 _eos();
                 string._eos();
             }
             else
             {
                 auto other_allocation = string._current_allocation();
-                string._become_small();
-                traits_type::copy(string._small_buffer, _small_buffer, _size);
+                string._become_small(this_size);
+                traits_type::copy(string._small_buffer, _small_buffer, this_size);
                 _become_large();
-                _large_buffer = other_allocation.elements;
-                _capacity = other_allocation.capacity;
-                std::swap(_size, string._size);
+                _set_allocation(other_allocation);
+                _set_size(other_size);
                 string._eos();
             }
         }
@@ -368,112 +588,205 @@ public:
             string.swap(*this); // Use the above case, but reverse the swapping order.
         else
         {
-            std::swap(_large_buffer, string._large_buffer);
-            std::swap(_size, string._size);
-            std::swap(_capacity, string._capacity);
+            std::swap(_large, string._large);
+            std::swap(_fields, string._fields);
         }
     }
 
 public:
-    // TODO: copy
+    // Copies a substring from this string to the destination.
+    constexpr size_type copy(pointer destination, size_type count, size_type position = 0) const
+    { return string_view_type(*this).copy(destination, count, position); }
+
+    // Returns a new string holding the substring of max length `count` starting from `offset`.
+    [[nodiscard]] constexpr basic_string substr(size_type offset = 0, size_type count = npos) const
+    { return basic_string(string_view_type(*this).substr(offset, count)); }
+
+    // Compares this string with a view.
+    [[nodiscard]] constexpr ssize_type compare(string_view_type view) const noexcept
+    { return string_view_type(*this).compare(view); }
+
+    // Compares a substring of this string with a view.
+    [[nodiscard]] constexpr ssize_type compare(size_type offset1, size_type count1, string_view_type view) const noexcept
+    { return string_view_type(*this).compare(offset1, count1, view); }
+
+    // Compares a substring of this string with a substring of a view.
+    [[nodiscard]] constexpr ssize_type compare(size_type offset1, size_type count1, string_view_type view, size_type offset2, size_type count2) const noexcept
+    { return string_view_type(*this).compare(offset1, count1, view, offset2, count2); }
+
+    // Returns if this string starts with the given view.
+    [[nodiscard]] constexpr bool starts_with(string_view_type view) const noexcept { return string_view_type(*this).starts_with(view); }
 
-    // TODO: substr
+    // Returns if this string ends with the given view.
+    [[nodiscard]] constexpr bool ends_with(string_view_type view) const noexcept { return string_view_type(*this).ends_with(view); }
 
-    // TODO: compare
+    // Returns if this string contains the given view.
+    [[nodiscard]] constexpr bool contains(string_view_type view) const noexcept { return string_view_type(*this).contains(view); }
 
-    // TODO: starts_with
+    // Returns if this string contains the given character.
+    [[nodiscard]] constexpr bool contains(value_type element) const noexcept { return string_view_type(*this).contains(element); }
 
-    // TODO: ends_with
+    // Returns the index of the first occurrence of the given view at or after `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type find(string_view_type view, size_type offset = 0) const noexcept
+    { return string_view_type(*this).find(view, offset); }
 
-    // TODO: contains
+    // Returns the index of the first occurrence of the given character at or after `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type find(value_type element, size_type offset = 0) const noexcept
+    { return string_view_type(*this).find(element, offset); }
 
-    // TODO: find
+    // Returns the index of the last occurrence of the given view starting at or before `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type rfind(string_view_type view, size_type offset = npos) const noexcept
+    { return string_view_type(*this).rfind(view, offset); }
 
-    // TODO: rfind
+    // Returns the index of the last occurrence of the given character at or before `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type rfind(value_type element, size_type offset = npos) const noexcept
+    { return string_view_type(*this).rfind(element, offset); }
 
-    // TODO: find_first_of
+    // Returns the index of the first character at or after `offset` that is in the given set, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_first_of(string_view_type set, size_type offset = 0) const noexcept
+    { return string_view_type(*this).find_first_of(set, offset); }
 
-    // TODO: find_first_not_of
+    // Returns the index of the first occurrence of the given character at or after `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_first_of(value_type element, size_type offset = 0) const noexcept
+    { return string_view_type(*this).find_first_of(element, offset); }
 
-    // TODO: fint_last_of
+    // Returns the index of the first character at or after `offset` that is not in the given set, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_first_not_of(string_view_type set, size_type offset = 0) const noexcept
+    { return string_view_type(*this).find_first_not_of(set, offset); }
 
-    // TODO: find_last_not_of
+    // Returns the index of the first character at or after `offset` that is not the given character, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_first_not_of(value_type element, size_type offset = 0) const noexcept
+    { return string_view_type(*this).find_first_not_of(element, offset); }
+
+    // Returns the index of the last character at or before `offset` that is in the given set, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_last_of(string_view_type set, size_type offset = npos) const noexcept
+    { return string_view_type(*this).find_last_of(set, offset); }
+
+    // Returns the index of the last occurrence of the given character at or before `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_last_of(value_type element, size_type offset = npos) const noexcept
+    { return string_view_type(*this).find_last_of(element, offset); }
+
+    // Returns the index of the last character at or before `offset` that is not in the given set, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_last_not_of(string_view_type set, size_type offset = npos) const noexcept
+    { return string_view_type(*this).find_last_not_of(set, offset); }
+
+    // Returns the index of the last character at or before `offset` that is not the given character, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_last_not_of(value_type element, size_type offset = npos) const noexcept
+    { return string_view_type(*this).find_last_not_of(element, offset); }
 
 public:
     [[nodiscard]] constexpr iterator begin() noexcept { return iterator(_elements()); }
-    [[nodiscard]] constexpr iterator end() noexcept { return iterator(_elements() + _size); }
-    [[nodiscard]] constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(_elements() + _size); }
+    [[nodiscard]] constexpr iterator end() noexcept { return iterator(_elements() + size()); }
+    [[nodiscard]] constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(_elements() + size()); }
     [[nodiscard]] constexpr reverse_iterator rend() noexcept { return reverse_iterator(_elements()); }
 
     [[nodiscard]] constexpr const_iterator begin() const noexcept { return const_iterator(_elements()); }
-    [[nodiscard]] constexpr const_iterator end() const noexcept { return const_iterator(_elements() + _size); }
-    [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(_elements() + _size); }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return const_iterator(_elements() + size()); }
+    [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(_elements() + size()); }
     [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(_elements()); }
 
     [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return const_iterator(_elements()); }
-    [[nodiscard]] constexpr const_iterator cend() const noexcept { return const_iterator(_elements() + _size); }
-    [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(_elements() + _size); }
+    [[nodiscard]] constexpr const_iterator cend() const noexcept { return const_iterator(_elements() + size()); }
+    [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(_elements() + size()); }
     [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(_elements()); }
 
 private:
-    // Initializes the string to be small or large, depending on the size.
-    constexpr void _init_from_size()
+    // Initializes the string with the given size, in small or large mode depending on it. The elements are left to the caller.
+    constexpr void _init_from_size(size_type new_size)
     {
-        if (_size <= _internal_capacity())
+        if (new_size <= _internal_capacity())
             _init_small();
         else
         {
             _init_large();
-            _allocate_current();
+            _set_allocation(_allocate(new_size));
         }
+        _set_size(new_size);
         _eos();
     }
 
-    // Starts the string in large mode. Assumes initially not in either mode.
+    // Starts the string in large mode, without an allocation. Assumes initially not in either mode.
     constexpr void _init_large() noexcept
     {
         if consteval
         {
             // Start lifetime of large buffer elements.
-            std::construct_at(std::addressof(_large_buffer));
+            std::construct_at(std::addressof(_large));
         }
+        if constexpr (_layout == string_layout::packed)
+            _large = { nullptr, 0, _large_flag };
     }
 
-    // Starts the string in small mode. Assumes initially not in either mode.
+    // Starts the string in small mode, empty. Assumes initially not in either mode.
     constexpr void _init_small() noexcept
     {
-        _capacity = _internal_capacity();
+        if constexpr (_layout == string_layout::packed)
+        {
+            if consteval
+            {
+                // Packed strings are never small when constant evaluated, so allocate what the small buffer would hold.
+                _init_large();
+                _set_allocation(_allocate(_internal_capacity()));
+                return;
+            }
+        }
+        else
+            _fields = { 0, _internal_capacity() };
         if consteval
         {
             // Start lifetime of small buffer elements.
             for (size_type i = 0; i <= _internal_capacity(); ++i)
                 std::construct_at(std::addressof(_small_buffer[i]));
         }
+        if constexpr (_layout == string_layout::packed)
+            _set_unused(_internal_capacity());
     }
 
-    // Puts the string in large mode. Assumes initially in small mode.
+    // Puts the string in large mode, keeping its size. Assumes initially in small mode.
     constexpr void _become_large() noexcept
     {
+        if constexpr (_layout == string_layout::packed)
+        {
+            // The size is about to be overwritten by the large buffer's fields, which hold it from then on.
+            _large = { nullptr, size(), _large_flag };
+        }
         if consteval
         {
             // End lifetime of small buffer.
             std::destroy_at(std::addressof(_small_buffer));
             // Start lifetime of large buffer.
-            std::construct_at(std::addressof(_large_buffer));
+            std::construct_at(std::addressof(_large));
         }
     }
 
-    // Puts the string in small mode. Assumes initially in large mode.
-    constexpr void _become_small() noexcept
+    // Puts the string in small mode with the given size, which must fit. Assumes initially
+    // in large mode, with the current allocation already taken care of by the caller.
+    constexpr void _become_small(size_type new_size) noexcept
     {
-        _capacity = _internal_capacity();
+        if constexpr (_layout == string_layout::packed)
+        {
+            if consteval
+            {
+                // Packed strings are never small when constant evaluated, so allocate what the small buffer would hold.
+                _set_allocation(_allocate(_internal_capacity()));
+                _large.size = new_size;
+                return;
+            }
+        }
+        else
+        {
+            _fields.capacity = _internal_capacity();
+            _set_size(new_size);
+        }
         if consteval
         {
             // End lifetime of large buffer.
-            std::destroy_at(std::addressof(_large_buffer));
+            std::destroy_at(std::addressof(_large));
             // Start lifetime of small buffer.
             std::construct_at(std::addressof(_small_buffer));
         }
+        if constexpr (_layout == string_layout::packed)
+            _set_unused(static_cast<size_type>(_internal_capacity() - new_size));
     }
 
     // Puts the string in large mode, or if already in
@@ -486,22 +799,214 @@ private:
             _deallocate_current();
     }
 
-    // Sets the element at _size to the null terminator.
+    // Sets the size, leaving the null terminator to the caller.
+    constexpr void _set_size(size_type new_size) noexcept
+    {
+        if constexpr (_layout == string_layout::packed)
+        {
+            if (small())
+                _set_unused(static_cast<size_type>(_internal_capacity() - new_size));
+            else
+                _large.size = new_size;
+        }
+        else if constexpr (_layout == string_layout::spill)
+        {
+            if (_fields.capacity != _spilled)
+                _fields.size = static_cast<std::uint8_t>(new_size);
+            else
+                _set_spill_header_field(0, new_size);
+        }
+        else
+            _fields.size = new_size;
+    }
+
+    // Returns the capacity of the large buffer. Assumes in large mode.
+    constexpr size_type _large_capacity() const noexcept
+    {
+        if constexpr (_layout == string_layout::packed)
+            return static_cast<size_type>(_large.capacity & ~_large_flag);
+        else
+            return capacity();
+    }
+
+    // Returns the number of unused elements in the small buffer of a packed string, which its last element holds.
+    constexpr size_type _unused() const noexcept
+    {
+        return static_cast<size_type>(static_cast<std::make_unsigned_t<value_type>>(_small_buffer[_internal_capacity()]));
+    }
+
+    // Sets the number of unused elements in the small buffer of a packed string. When there are none, it's the null terminator.
+    constexpr void _set_unused(size_type unused) noexcept
+    {
+        _small_buffer[_internal_capacity()] = static_cast<value_type>(unused);
+    }
+
+    // Returns the size (0) or capacity (1) from the header before a spilled string's elements.
+    // The header is made of elements, little-endian, so it can be read and written at compile time.
+    constexpr size_type _spill_header_field(std::size_t field) const noexcept
+    {
+        const_pointer units = _large.elements - _spill_header_units + field * _spill_field_units;
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < _spill_field_units; ++i)
+            value |= std::uint64_t(static_cast<std::make_unsigned_t<value_type>>(units[i])) << (8 * sizeof(value_type) * i);
+        return static_cast<size_type>(value);
+    }
+
+    // Sets the size (0) or capacity (1) in the header before a spilled string's elements.
+    constexpr void _set_spill_header_field(std::size_t field, size_type value) noexcept
+    {
+        pointer units = _large.elements - _spill_header_units + field * _spill_field_units;
+        for (std::size_t i = 0; i < _spill_field_units; ++i)
+            units[i] = static_cast<value_type>(static_cast<std::make_unsigned_t<value_type>>(std::uint64_t(value) >> (8 * sizeof(value_type) * i)));
+    }
+
+    // Sets the element at the size to the null terminator.
     constexpr void _eos() noexcept
     {
-        traits_type::assign(_elements()[_size], nult);
+        traits_type::assign(_elements()[size()], nult);
     }
 
     // Gets the appropriate elements.
     constexpr pointer _elements() noexcept
     {
-        return small() ? _small_buffer : _large_buffer;
+        return small() ? _small_buffer : _large.elements;
     }
 
     // g++ still doesn't have "deducing this".
     constexpr const_pointer _elements() const noexcept
     {
-        return small() ? _small_buffer : _large_buffer;
+        return small() ? _small_buffer : _large.elements;
+    }
+
+    // Replaces the `count` elements at `position`, which must be in the string, with `new_count` elements written by
+    // `write(elements)`. They're written in place after moving the rest once, or into a new allocation before the old one
+    // is released, which grows geometrically. Nothing is replaced if the result wouldn't fit in the string.
+    template <typename _write_t>
+    constexpr void _splice(size_type position, size_type count, std::size_t new_count, _write_t write)
+    {
+        size_type old_size = size();
+        if (max_size() - (old_size - count) < new_count)
+            return;
+        size_type new_size = static_cast<size_type>(old_size - count + new_count);
+        size_type tail = static_cast<size_type>(old_size - position - count);
+        if (capacity() < new_size)
+        {
+            auto allocation = _allocate(_grown_capacity(new_size));
+            traits_type::copy(allocation.elements, _elements(), position);
+            std::move(write)(allocation.elements + position);
+            traits_type::copy(allocation.elements + position + new_count, _elements() + position + count, tail);
+            _adopt(allocation);
+        }
+        else
+        {
+            pointer elements = _elements();
+            traits_type::move(elements + position + new_count, elements + position + count, tail);
+            std::move(write)(elements + position);
+        }
+        _set_size(new_size);
+        _eos();
+    }
+
+    // Truncates the string to its first `new_size` elements after they've been compacted, moving it back into the
+    // small buffer if the policy says to and it fits. Returns how many elements were erased.
+    constexpr size_type _erase_to(size_type new_size, erase_policy policy) noexcept
+    {
+        size_type erased = static_cast<size_type>(size() - new_size);
+        _set_size(new_size);
+        _eos();
+        if (policy == erase_policy::shrink_to_small && !small() && new_size <= _internal_capacity())
+            shrink_to_fit();
+        return erased;
+    }
+
+    // Returns the capacity to grow to for `new_size` elements. Growing is usually repeated, so the capacity grows geometrically.
+    constexpr size_type _grown_capacity(size_type new_size) const noexcept
+    {
+        return static_cast<size_type>(std::min<std::size_t>(std::max<std::size_t>(new_size, 2 * std::size_t(capacity())), max_size()));
+    }
+
+    // Returns if the view points into the elements, which moving them could overwrite.
+    constexpr bool _overlaps(string_view_type view) const noexcept
+    {
+        if consteval
+        {
+            // Pointers into different objects can't be ordered when constant evaluated, so assume the worst.
+            return true;
+        }
+        else
+        {
+            const_pointer elements = _elements();
+            return std::less_equal<>()(elements, view.data()) && std::less<>()(view.data(), elements + capacity() + 1);
+        }
+    }
+
+    // Replaces every occurrence of the needle in this string with the replacement, storing the result in `destination`,
+    // which is either this string, or a string that neither view points into.
+    constexpr size_type _replace_all_into(basic_string& destination, string_view_type needle, string_view_type replacement) const
+    {
+        string_view_type view(*this);
+        if (needle.empty() || size() < needle.size())
+            return 0;
+
+        // Shrinking never writes past what's yet to be read, so it's done in place.
+        if (replacement.size() <= needle.size() && std::addressof(destination) == this)
+        {
+            auto [size, count] = _replace_forward(destination._elements(), view, needle, replacement);
+            destination._set_size(size);
+            destination._eos();
+            return count;
+        }
+
+        size_type count = 0;
+        for (size_type found = view.find(needle); found != npos; found = view.find(needle, found + needle.size()))
+            ++count;
+        if (count == 0)
+            return 0;
+        std::size_t new_size = size() - std::size_t(count) * needle.size();
+        if ((destination.max_size() - new_size) / count < replacement.size())
+            return 0;
+        new_size += std::size_t(count) * replacement.size();
+
+        if (destination.capacity() < new_size)
+        {
+            auto allocation = destination._allocate(static_cast<size_type>(new_size));
+            _replace_forward(allocation.elements, view, needle, replacement);
+            destination._adopt(allocation);
+        }
+        else if (std::addressof(destination) != this)
+            _replace_forward(destination._elements(), view, needle, replacement);
+        else
+        {
+            // Move the contents to the end of the capacity, so the replacements written from the front never catch up with them.
+            pointer elements = destination._elements();
+            pointer moved = elements + (capacity() - view.size());
+            traits_type::move(moved, elements, view.size());
+            _replace_forward(elements, string_view_type(moved, view.size()), needle, replacement);
+        }
+        destination._set_size(static_cast<size_type>(new_size));
+        destination._eos();
+        return count;
+    }
+
+    // Writes the source with every occurrence of the needle replaced to the destination, which may overlap the source,
+    // as long as what's written never passes what's yet to be read. Returns the number of elements written and of replacements.
+    static constexpr std::pair<size_type, size_type> _replace_forward(pointer destination, string_view_type source, string_view_type needle, string_view_type replacement) noexcept
+    {
+        pointer written = destination;
+        size_type count = 0;
+        size_type read = 0;
+        for (size_type found = source.find(needle); found != npos; found = source.find(needle, read))
+        {
+            traits_type::move(written, source.data() + read, found - read);
+            written += found - read;
+            traits_type::copy(written, replacement.data(), replacement.size());
+            written += replacement.size();
+            read = static_cast<size_type>(found + needle.size());
+            ++count;
+        }
+        traits_type::move(written, source.data() + read, source.size() - read);
+        written += source.size() - read;
+        return { static_cast<size_type>(written - destination), count };
     }
 
 private:
@@ -513,25 +1018,80 @@ private:
 
     constexpr _allocation _allocate(size_type element_count)
     {
-        // g++ still doesn't have allocator size feedback.
-        return { allocator_traits::allocate(_allocator, element_count + 1), element_count };
+        // Counted in std::size_t, since std::uint32_t arithmetic wraps where narrower size types promote to int.
+        std::size_t header = 0;
+        size_type max_capacity = max_size();
+        if constexpr (_layout == string_layout::spill)
+        {
+            if (element_count > _spill_inline_capacity)
+                header = _spill_header_units;
+            else
+                max_capacity = _spill_inline_capacity;
+        }
+        std::size_t count = std::size_t(element_count) + 1 + header;
+
+        // With size feedback, the capacity fills whatever the allocator handed out, as far as the fields can describe it.
+        // g++ still doesn't have std::allocator_traits::allocate_at_least, so it's called on the allocator itself.
+        if constexpr (requires { _allocator.allocate_at_least(count); })
+        {
+            auto [elements, allocated] = _allocator.allocate_at_least(count);
+            return { elements + header, static_cast<size_type>(std::min<std::size_t>(allocated - 1 - header, max_capacity)) };
+        }
+        else
+            return { allocator_traits::allocate(_allocator, count) + header, element_count };
     }
 
     constexpr void _deallocate(_allocation allocation) noexcept
     {
-        allocator_traits::deallocate(_allocator, allocation.elements, allocation.capacity + 1);
+        if constexpr (_layout == string_layout::spill)
+        {
+            if (allocation.capacity > _spill_inline_capacity)
+            {
+                allocator_traits::deallocate(_allocator, allocation.elements - _spill_header_units, std::size_t(allocation.capacity) + 1 + _spill_header_units);
+                return;
+            }
+        }
+        allocator_traits::deallocate(_allocator, allocation.elements, std::size_t(allocation.capacity) + 1);
     }
 
-    constexpr void _allocate_current()
+    constexpr _allocation _current_allocation() { return { _large.elements, _large_capacity() }; }
+
+    constexpr void _deallocate_current() noexcept { _deallocate(_current_allocation()); }
+
+    // Replaces the current allocation, if any, with the given one, keeping the size. The null terminator is left to the caller.
+    constexpr void _adopt(_allocation allocation) noexcept
     {
-        auto allocation = _allocate(_size);
-        _large_buffer = allocation.elements;
-        _capacity = allocation.capacity;
+        [[maybe_unused]] size_type old_size = size();
+        if (small())
+            _become_large();
+        else
+            _deallocate_current();
+        _set_allocation(allocation);
+        // A spilled size was in the old allocation's header, and moves to wherever the new allocation keeps it.
+        if constexpr (_layout == string_layout::spill)
+            _set_size(old_size);
     }
 
-    constexpr _allocation _current_allocation() { return { _large_buffer, _capacity }; }
-
-    constexpr void _deallocate_current() noexcept { _deallocate(_current_allocation()); }
+    // Points the large buffer at the given allocation. Assumes in large mode, with the current allocation, if any, taken care of.
+    // A spilled string's size is left to the caller, since its header is part of the allocation.
+    constexpr void _set_allocation(_allocation allocation) noexcept
+    {
+        _large.elements = allocation.elements;
+        if constexpr (_layout == string_layout::packed)
+            _large.capacity = allocation.capacity | _large_flag;
+        else if constexpr (_layout == string_layout::spill)
+        {
+            if (allocation.capacity <= _spill_inline_capacity)
+                _fields.capacity = static_cast<std::uint8_t>(allocation.capacity);
+            else
+            {
+                _fields.capacity = _spilled;
+                _set_spill_header_field(1, allocation.capacity);
+            }
+        }
+        else
+            _fields.capacity = allocation.capacity;
+    }
 
 private:
     // Calculate the number of elements the small buffer can hold.
@@ -539,13 +1099,24 @@ private:
     {
         static_assert(alignof(value_type) <= alignof(pointer));
 
+        if constexpr (_layout == string_layout::packed)
+        {
+            // The small buffer spans the pointer, size and capacity, and is ended by the number of unused elements.
+            constexpr size_type internal_capacity = (sizeof(pointer) + 2 * sizeof(size_type)) / sizeof(value_type) - 1;
+            static_assert(_min_internal_capacity <= internal_capacity, "The packed layout's small buffer can't grow.");
+            return internal_capacity;
+        }
+
+        // The spill layout's size and capacity are a byte each.
+        constexpr std::size_t field_bytes = 2 * (_layout == string_layout::spill ? sizeof(std::uint8_t) : sizeof(size_type));
+
         // There's a guaranteed alignof(pointer) bytes available.
         size_type internal_capacity = alignof(pointer) / sizeof(value_type) - 1; // - 1 for null terminator.
         // Expand small buffer if there would be usable padding after
-        // _size and _capacity. This effectively moves it before them,
+        // the size and capacity. This effectively moves it before them,
         // appending it to the small buffer so it can be used.
-        if (2 * sizeof(size_type) < alignof(pointer))
-            internal_capacity += (alignof(pointer) - 2 * sizeof(size_type)) / sizeof(value_type);
+        if (field_bytes < alignof(pointer))
+            internal_capacity += (alignof(pointer) - field_bytes) / sizeof(value_type);
 
         // Grow the small buffer until it can store the required number of elements.
         while (internal_capacity < _min_internal_capacity)
@@ -556,29 +1127,192 @@ private:
 public: // Must be after _internal_capacity is defined. Thanks C++.
     // Small Buffer Optimization Capacity.
     static constexpr size_type sboc = _internal_capacity();
+    static_assert(_layout != string_layout::spill || sboc < 0xFE, "The spill layout's small buffer must leave byte capacities for large strings.");
+
+    // Returns how this string type lays out its state in memory.
+    [[nodiscard]] static consteval string_layout_info layout_info() noexcept
+    {
+        constexpr std::size_t buffer_size = sizeof(value_type) * (_internal_capacity() + 1);
+        std::size_t size_offset = 0;
+        std::size_t capacity_offset = 0;
+        std::size_t field_bytes = 0; // Outside the union.
+        std::size_t field_size = sizeof(size_type);
+        if constexpr (_layout == string_layout::packed)
+        {
+            size_offset = offsetof(basic_string, _large.size);
+            capacity_offset = offsetof(basic_string, _large.capacity);
+        }
+        else
+        {
+            size_offset = offsetof(basic_string, _fields.size);
+            capacity_offset = offsetof(basic_string, _fields.capacity);
+            field_bytes = sizeof(_fields);
+            field_size = sizeof(_fields.size);
+        }
+        return {
+            .layout = _layout,
+            .size = sizeof(basic_string),
+            .alignment = alignof(basic_string),
+            .sboc = _internal_capacity(),
+            .max_length = (std::size_t(std::numeric_limits<ssize_type>::max()) - 1) / sizeof(value_type),
+            .buffer_offset = offsetof(basic_string, _small_buffer),
+            .buffer_size = buffer_size,
+            .size_offset = size_offset,
+            .capacity_offset = capacity_offset,
+            .field_size = field_size,
+            .padding = sizeof(basic_string) - std::max(buffer_size, sizeof(_large)) - field_bytes,
+        };
+    }
 
 private:
-    // Remove trailing padding for the union so _size and _capacity are placed in it.
+    // The state of a large string that shares its bytes with the small buffer.
+    struct _standard_large
+    {
+        pointer elements;
+    };
+    struct _packed_large
+    {
+        pointer elements;
+        size_type size;
+        size_type capacity; // The top bit is set, telling the modes apart.
+    };
+
+    // The state that follows the union, which only the standard layout has.
+    struct _standard_fields
+    {
+        size_type size;
+        size_type capacity;
+    };
+    struct _packed_fields {};
+    struct _spill_fields
+    {
+        std::uint8_t size;
+        std::uint8_t capacity; // _spilled if the size and capacity are in the header.
+    };
+
+    // The largest capacity a spill string keeps in its byte, and the sentinel saying they've spilled into the header.
+    static constexpr size_type _spill_inline_capacity = static_cast<size_type>(std::min<std::size_t>(0xFE, std::numeric_limits<size_type>::max()));
+    static constexpr std::uint8_t _spilled = 0xFF;
+    static constexpr std::size_t _spill_field_units = (sizeof(size_type) + sizeof(value_type) - 1) / sizeof(value_type);
+    static constexpr std::size_t _spill_header_units = 2 * _spill_field_units;
+
+    static constexpr size_type _large_flag = static_cast<size_type>(size_type(1) << (8 * sizeof(size_type) - 1));
+
+    // Remove trailing padding for the union so _fields is placed in it.
     #pragma pack(push, 1)
     union
     {
         value_type _small_buffer[_internal_capacity() + 1]; // + 1 for null terminator.
-        pointer _large_buffer;
+        std::conditional_t<_layout == string_layout::packed, _packed_large, _standard_large> _large;
     };
     #pragma pack(pop)
-    size_type _size;
-    size_type _capacity;
+    [[no_unique_address]] std::conditional_t<_layout == string_layout::packed, _packed_fields,
+        std::conditional_t<_layout == string_layout::spill, _spill_fields, _standard_fields>> _fields;
     [[no_unique_address]] allocator_type _allocator;
     // The previous pragma push, for some reason, applies to the whole class, this overrides that.
 } __attribute__((aligned(alignof(pointer))));
 
+// Appends `count` elements to the string, written by `write(elements)` where `elements` points past the old contents.
+// Appending to existing contents is usually repeated, so the capacity grows geometrically.
+// Nothing is appended if the result would not fit in the string.
+template <typename _string_t, typename _write_t>
+constexpr void _append_overwrite(_string_t& string, std::size_t count, _write_t write)
+{
+    std::size_t old_size = string.size();
+    if (string.max_size() - old_size < count)
+        return;
+    std::size_t new_size = old_size + count;
+    if (old_size != 0 && string.capacity() < new_size)
+        string.reserve(static_cast<typename _string_t::size_type>(std::min<std::size_t>(std::max<std::size_t>(new_size, 2 * string.capacity()), string.max_size())));
+    string.resize_and_overwrite(static_cast<typename _string_t::size_type>(new_size), [&write, old_size, new_size](auto* elements, auto)
+    {
+        std::move(write)(elements + old_size);
+        return new_size;
+    });
+}
+
+// Compares two strings.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+constexpr bool operator==(
+    const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& a,
+    const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& b
+) noexcept
+{
+    return basic_string_view<_char_t, _size_t, _traits_t>(a) == basic_string_view<_char_t, _size_t, _traits_t>(b);
+}
+
+// Compares a string with a view.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+constexpr bool operator==(
+    const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& a,
+    basic_string_view<_char_t, _size_t, _traits_t> b
+) noexcept
+{
+    return basic_string_view<_char_t, _size_t, _traits_t>(a) == b;
+}
+
+// Compares two strings.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+constexpr std::strong_ordering operator<=>(
+    const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& a,
+    const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& b
+) noexcept
+{
+    return basic_string_view<_char_t, _size_t, _traits_t>(a) <=> basic_string_view<_char_t, _size_t, _traits_t>(b);
+}
+
+// Compares a string with a view.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+constexpr std::strong_ordering operator<=>(
+    const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& a,
+    basic_string_view<_char_t, _size_t, _traits_t> b
+) noexcept
+{
+    return basic_string_view<_char_t, _size_t, _traits_t>(a) <=> b;
+}
+
+// Hashes a string the same as its view, so views can be used to look up string keys
+// in unordered containers whose equality is transparent, e.g. std::equal_to<>.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+struct std::hash<::basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>>
+{
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t operator()(::basic_string_view<_char_t, _size_t, _traits_t> view) const noexcept { return _hash_string(view); }
+};
+
 using string = basic_string<char, std::size_t>;
 using small_string = basic_string<char, std::uint8_t>;
+using compact_string = basic_string<char, std::uint32_t>;
 using u8string = basic_string<char8_t, std::size_t>;
 using small_u8string = basic_string<char8_t, std::uint8_t>;
+using compact_u8string = basic_string<char8_t, std::uint32_t>;
 using u16string = basic_string<char16_t, std::size_t>;
 using small_u16string = basic_string<char16_t, std::uint8_t>;
+using compact_u16string = basic_string<char16_t, std::uint32_t>;
 using u32string = basic_string<char32_t, std::size_t>;
 using small_u32string = basic_string<char32_t, std::uint8_t>;
+using compact_u32string = basic_string<char32_t, std::uint32_t>;
 using wstring = basic_string<wchar_t, std::size_t>;
 using small_wstring = basic_string<wchar_t, std::uint8_t>;
+using compact_wstring = basic_string<wchar_t, std::uint32_t>;
+
+// Strings with the packed layout, which are 24 bytes with a std::size_t, holding 23 chars inline, and 16 bytes with a std::uint32_t.
+template <typename _char_t, typename _size_t = std::size_t>
+using basic_packed_string = basic_string<_char_t, _size_t, 15 / sizeof(_char_t), std::char_traits<_char_t>, STRING_DEFAULT_ALLOCATOR, string_layout::packed>;
+
+using packed_string = basic_packed_string<char>;
+using packed_u8string = basic_packed_string<char8_t>;
+using packed_u16string = basic_packed_string<char16_t>;
+using packed_u32string = basic_packed_string<char32_t>;
+using packed_wstring = basic_packed_string<wchar_t>;
+
+// Strings with the spill layout, which are 24 bytes holding 21 chars inline like small_string, but can grow past 126.
+template <typename _char_t>
+using basic_spill_string = basic_string<_char_t, std::size_t, 15 / sizeof(_char_t), std::char_traits<_char_t>, STRING_DEFAULT_ALLOCATOR, string_layout::spill>;
+
+using spill_string = basic_spill_string<char>;
+using spill_u8string = basic_spill_string<char8_t>;
+using spill_u16string = basic_spill_string<char16_t>;
+using spill_u32string = basic_spill_string<char32_t>;
+using spill_wstring = basic_spill_string<wchar_t>;
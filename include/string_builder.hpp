@@ -0,0 +1,193 @@
+#pragma once
+
+#include "string.hpp"
+#include <cerrno>
+#include <climits>
+#include <deque>
+#include <span>
+#include <sys/uio.h>
+#include <vector>
+
+// Accumulates pieces of text without copying them into one string, for a single writev call or a single allocation.
+// Views are borrowed, so what they refer to must outlive the builder. Owned strings are kept by the builder.
+// Tiny pieces are copied into an internal chunk instead, so that adjacent ones coalesce into one I/O vector.
+template
+<
+    typename _char_t,
+    typename _size_t = std::size_t,
+    _size_t _min_internal_capacity = 15 / sizeof(_char_t),
+    typename _traits_t = std::char_traits<_char_t>,
+    typename _allocator_t = STRING_DEFAULT_ALLOCATOR,
+    string_layout _layout = string_layout::standard
+>
+class basic_string_builder
+{
+public:
+    using string_type = basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>;
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+    using value_type = _char_t;
+    using size_type = _size_t;
+
+    // Pieces up to this many characters are copied rather than referred to.
+    static constexpr std::size_t coalesce_size = 64 / sizeof(_char_t);
+    // The capacity of each internal chunk that tiny pieces are copied into.
+    static constexpr std::size_t chunk_size = 4096 / sizeof(_char_t);
+
+public:
+    [[nodiscard]] basic_string_builder() = default;
+
+    // The I/O vectors may point into the builder's own storage, which is referred to by address.
+    basic_string_builder(const basic_string_builder&) = delete;
+    basic_string_builder& operator=(const basic_string_builder&) = delete;
+
+public:
+    // Appends a borrowed view, which is copied only if it's tiny.
+    basic_string_builder& append(string_view_type view)
+    {
+        if (view.size() <= coalesce_size)
+            return append_copy(view);
+        _add(view.data(), view.size());
+        return *this;
+    }
+
+    // Appends an owned string, which is moved into the builder unless it's tiny.
+    basic_string_builder& append(string_type&& string)
+    {
+        if (string.size() <= coalesce_size)
+            return append_copy(string);
+        const string_type& owned = _storage.emplace_back(std::move(string));
+        _add(owned.data(), owned.size());
+        return *this;
+    }
+
+    // Appends a copy of the view, e.g. for a temporary.
+    basic_string_builder& append_copy(string_view_type view)
+    {
+        if (view.empty())
+            return *this;
+        if (_chunk == nullptr || _chunk->capacity() - _chunk->size() < view.size())
+        {
+            _chunk = std::addressof(_storage.emplace_back());
+            _chunk->reserve(static_cast<size_type>(std::min<std::size_t>(std::max<std::size_t>(chunk_size, view.size()), _chunk->max_size())));
+        }
+        // The chunk has the capacity, so the copy stays where the previous one ended and can coalesce with it.
+        std::size_t offset = _chunk->size();
+        _chunk->resize_and_overwrite(static_cast<size_type>(offset + view.size()), [view, offset](_char_t* elements, auto count)
+        {
+            _traits_t::copy(elements + offset, view.data(), view.size());
+            return count;
+        });
+        _add(_chunk->data() + offset, view.size());
+        return *this;
+    }
+
+    // Appends a character.
+    basic_string_builder& append(value_type element) { return append_copy(string_view_type(&element, 1)); }
+
+    basic_string_builder& operator<<(string_view_type view) { return append(view); }
+    basic_string_builder& operator<<(string_type&& string) { return append(std::move(string)); }
+    basic_string_builder& operator<<(const value_type* elements) { return append(string_view_type(elements)); }
+    basic_string_builder& operator<<(value_type element) { return append(element); }
+
+    // Removes every piece, releasing the owned strings and chunks.
+    void clear() noexcept
+    {
+        _vectors.clear();
+        _storage.clear();
+        _chunk = nullptr;
+        _size = 0;
+    }
+
+public:
+    // Returns the total number of characters.
+    [[nodiscard]] std::size_t size() const noexcept { return _size; }
+
+    // Returns if there are no characters.
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+    // Returns the pieces as I/O vectors, for writev.
+    [[nodiscard]] std::span<const iovec> iovecs() const noexcept { return _vectors; }
+
+    // Appends every piece to the string, allocating at most once.
+    void append_to(string_type& string) const
+    {
+        _append_overwrite(string, _size, [this](_char_t* elements)
+        {
+            for (const iovec& vector : _vectors)
+            {
+                std::size_t count = vector.iov_len / sizeof(_char_t);
+                _traits_t::copy(elements, static_cast<const _char_t*>(vector.iov_base), count);
+                elements += count;
+            }
+        });
+    }
+
+    // Returns every piece in one string, allocated once.
+    [[nodiscard]] string_type to_string() const
+    {
+        string_type string;
+        append_to(string);
+        return string;
+    }
+
+    // Writes every piece to the file descriptor, with as few writev calls as partial writes and IOV_MAX allow.
+    // Returns if everything was written, otherwise error() returns the errno value.
+    bool write(int descriptor)
+    {
+        std::size_t index = 0;
+        std::size_t written = 0; // Of the vector at index.
+        while (index < _vectors.size())
+        {
+            // Skip what was written of the first vector, then put it back.
+            iovec first = _vectors[index];
+            _vectors[index].iov_base = static_cast<char*>(first.iov_base) + written;
+            _vectors[index].iov_len -= written;
+            ssize_t count = ::writev(descriptor, _vectors.data() + index, static_cast<int>(std::min<std::size_t>(_vectors.size() - index, IOV_MAX)));
+            _vectors[index] = first;
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                _error = errno;
+                return false;
+            }
+
+            std::size_t remaining = static_cast<std::size_t>(count) + written;
+            for (; index < _vectors.size() && _vectors[index].iov_len <= remaining; ++index)
+                remaining -= _vectors[index].iov_len;
+            written = remaining;
+        }
+        return true;
+    }
+
+    // Returns the errno value of the last failure to write to a file descriptor, or 0.
+    [[nodiscard]] int error() const noexcept { return _error; }
+
+private:
+    // Adds a piece, extending the last one if it ends where this one starts.
+    void _add(const _char_t* data, std::size_t size)
+    {
+        _size += size;
+        if (!_vectors.empty())
+        {
+            iovec& last = _vectors.back();
+            if (static_cast<const char*>(last.iov_base) + last.iov_len == reinterpret_cast<const char*>(data))
+            {
+                last.iov_len += size * sizeof(_char_t);
+                return;
+            }
+        }
+        _vectors.push_back({ const_cast<_char_t*>(data), size * sizeof(_char_t) });
+    }
+
+private:
+    std::vector<iovec> _vectors;
+    // Owned strings and chunks. A deque never moves its elements when growing, so their small buffers stay put.
+    std::deque<string_type> _storage;
+    string_type* _chunk = nullptr;
+    std::size_t _size = 0;
+    int _error = 0;
+};
+
+using string_builder = basic_string_builder<char>;
+using u8string_builder = basic_string_builder<char8_t>;
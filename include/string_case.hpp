@@ -0,0 +1,322 @@
+#pragma once
+
+#include "string_case_table.hpp"
+#include "string_unicode.hpp"
+#include <algorithm>
+
+// Character types whose non-ASCII characters are case mapped as Unicode.
+// Every other character type only has its ASCII letters mapped.
+template <typename _char_t>
+concept _unicode_cased = std::same_as<_char_t, char8_t> || std::same_as<_char_t, char16_t> || std::same_as<_char_t, char32_t>;
+
+enum class _case_mapping { lower, upper, fold };
+
+// Maps an ASCII letter, leaving every other value as is.
+template <_case_mapping _mapping>
+constexpr std::uint32_t _map_ascii_case(std::uint32_t unit) noexcept
+{
+    if constexpr (_mapping == _case_mapping::upper)
+        return 'a' <= unit && unit <= 'z' ? unit - 0x20 : unit;
+    else
+        return 'A' <= unit && unit <= 'Z' ? unit + 0x20 : unit;
+}
+
+// Maps a code point with the simple Unicode case mappings.
+template <_case_mapping _mapping>
+constexpr char32_t _map_case(char32_t code_point) noexcept
+{
+    if (code_point < 0x80)
+        return _map_ascii_case<_mapping>(code_point);
+
+    auto map = [code_point](const auto& table)
+    {
+        auto run = std::lower_bound(std::begin(table), std::end(table), code_point,
+            [](const _case_run& run, char32_t code_point) { return run.last < code_point; });
+        if (run != std::end(table) && run->first <= code_point && (code_point - run->first) % run->stride == 0)
+            return static_cast<char32_t>(static_cast<std::int32_t>(code_point) + run->delta);
+        return code_point;
+    };
+    if constexpr (_mapping == _case_mapping::lower)
+        return map(_lowercase_table);
+    else if constexpr (_mapping == _case_mapping::upper)
+        return map(_uppercase_table);
+    else
+        return map(_case_folding_table);
+}
+
+// Maps the ASCII letters of the leading units, stopping at the first non-ASCII unit
+// of Unicode cased types. `source` and `destination` may be the same.
+template <_case_mapping _mapping, typename _char_t>
+constexpr std::size_t _map_ascii_case_run(const _char_t* source, std::size_t size, _char_t* destination) noexcept
+{
+    std::size_t i = 0;
+    if !consteval
+    {
+        i = _convert_ascii_case_blocks<_mapping == _case_mapping::upper, _unicode_cased<_char_t>>(source, size, destination);
+    }
+    for (; i < size; ++i)
+    {
+        std::uint32_t unit = _code_unit(source[i]);
+        if (_unicode_cased<_char_t> && unit >= 0x80)
+            break;
+        destination[i] = static_cast<_char_t>(_map_ascii_case<_mapping>(unit));
+    }
+    return i;
+}
+
+// Returns the number of code units the mapped input takes.
+template <_case_mapping _mapping, typename _char_t>
+constexpr std::size_t _case_mapped_length(const _char_t* data, std::size_t size) noexcept
+{
+    if constexpr (!_unicode_cased<_char_t>)
+        return size;
+    else
+    {
+        std::size_t length = 0;
+        for (std::size_t i = 0; i < size;)
+        {
+            if !consteval
+            {
+                std::size_t run = _ascii_prefix_length(data + i, size - i);
+                length += run;
+                i += run;
+                if (i == size)
+                    break;
+            }
+            auto decoded = _decode(data, size, i);
+            length += decoded.valid ? _encoded_length<_char_t>(_map_case<_mapping>(decoded.code_point)) : decoded.length;
+            i += decoded.length;
+        }
+        return length;
+    }
+}
+
+// Maps the input into exactly `_case_mapped_length` code units. Ill-formed sequences are copied as is.
+template <_case_mapping _mapping, typename _char_t>
+constexpr void _map_case_to(const _char_t* data, std::size_t size, _char_t* destination) noexcept
+{
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < size;)
+    {
+        std::size_t run = _map_ascii_case_run<_mapping>(data + i, size - i, destination + written);
+        written += run;
+        i += run;
+        if (i == size)
+            break;
+
+        if constexpr (_unicode_cased<_char_t>)
+        {
+            auto decoded = _decode(data, size, i);
+            if (decoded.valid)
+                written += _encode(_map_case<_mapping>(decoded.code_point), destination + written);
+            else
+                written += std::copy_n(data + i, decoded.length, destination + written) - (destination + written);
+            i += decoded.length;
+        }
+    }
+}
+
+// Makes the destination hold `prefix` as is, followed by the mapped input, allocating at most once.
+template <_case_mapping _mapping, typename _string_t, typename _char_t>
+constexpr void _assign_case_mapped(_string_t& destination, const _char_t* prefix, std::size_t prefix_size, const _char_t* data, std::size_t size)
+{
+    std::size_t length = prefix_size + _case_mapped_length<_mapping>(data, size);
+    if (destination.max_size() < length)
+        return;
+    destination.resize_and_overwrite(static_cast<typename _string_t::size_type>(length), [=](_char_t* elements, auto)
+    {
+        std::copy_n(prefix, prefix_size, elements);
+        _map_case_to<_mapping>(data, size, elements + prefix_size);
+        return length;
+    });
+}
+
+// Maps the string in place, unless a character's mapping has a different encoded length.
+template <_case_mapping _mapping, typename _string_t>
+constexpr void _map_case_in_place(_string_t& string)
+{
+    using char_type = typename _string_t::value_type;
+    char_type* data = string.data();
+    std::size_t size = string.size();
+    for (std::size_t i = 0; i < size;)
+    {
+        i += _map_ascii_case_run<_mapping>(data + i, size - i, data + i);
+        if (i == size)
+            break;
+
+        if constexpr (_unicode_cased<char_type>)
+        {
+            auto decoded = _decode(data, size, i);
+            char32_t mapped = decoded.valid ? _map_case<_mapping>(decoded.code_point) : decoded.code_point;
+            if (mapped != decoded.code_point)
+            {
+                if (_encoded_length<char_type>(mapped) != decoded.length)
+                {
+                    // Keep the part already mapped, and map the rest out of place.
+                    _string_t result;
+                    _assign_case_mapped<_mapping>(result, data, i, data + i, size - i);
+                    string = std::move(result);
+                    return;
+                }
+                _encode(mapped, data + i);
+            }
+            i += decoded.length;
+        }
+    }
+}
+
+// Converts the string to lowercase in place.
+// Only ASCII letters are converted, unless the character type is char8_t, char16_t or char32_t,
+// in which case every character is converted with the simple Unicode case mappings.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+constexpr void to_lower(basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string)
+{
+    _map_case_in_place<_case_mapping::lower>(string);
+}
+
+// Converts the string to uppercase in place.
+// Only ASCII letters are converted, unless the character type is char8_t, char16_t or char32_t,
+// in which case every character is converted with the simple Unicode case mappings.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+constexpr void to_upper(basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string)
+{
+    _map_case_in_place<_case_mapping::upper>(string);
+}
+
+// Makes the destination the lowercase of the view, reusing its allocation if large enough.
+// The view must not refer to the destination.
+template <typename _char_t, typename _size_t, typename _traits_t, typename _string_t>
+    requires std::same_as<typename _string_t::value_type, _char_t>
+constexpr void to_lower(basic_string_view<_char_t, _size_t, _traits_t> view, _string_t& destination)
+{
+    _assign_case_mapped<_case_mapping::lower>(destination, view.data(), 0, view.data(), view.size());
+}
+
+// Makes the destination the uppercase of the view, reusing its allocation if large enough.
+// The view must not refer to the destination.
+template <typename _char_t, typename _size_t, typename _traits_t, typename _string_t>
+    requires std::same_as<typename _string_t::value_type, _char_t>
+constexpr void to_upper(basic_string_view<_char_t, _size_t, _traits_t> view, _string_t& destination)
+{
+    _assign_case_mapped<_case_mapping::upper>(destination, view.data(), 0, view.data(), view.size());
+}
+
+// Compares two inputs ignoring case, from `*i` and `*j` onward, leaving them at the first difference.
+// Returns the difference between the case folded characters there, or 0 if either input ended.
+template <typename _char_t>
+constexpr std::int64_t _icompare_prefix(const _char_t* a, std::size_t a_size, std::size_t& i, const _char_t* b, std::size_t b_size, std::size_t& j) noexcept
+{
+    while (i < a_size && j < b_size)
+    {
+        if !consteval
+        {
+            std::size_t run = _ascii_iequal_blocks<_unicode_cased<_char_t>>(a + i, b + j, std::min(a_size - i, b_size - j));
+            i += run;
+            j += run;
+            if (i == a_size || j == b_size)
+                break;
+        }
+
+        std::uint32_t a_unit = _code_unit(a[i]);
+        std::uint32_t b_unit = _code_unit(b[j]);
+        if (!_unicode_cased<_char_t> || (a_unit < 0x80 && b_unit < 0x80))
+        {
+            auto a_folded = _map_ascii_case<_case_mapping::fold>(a_unit);
+            auto b_folded = _map_ascii_case<_case_mapping::fold>(b_unit);
+            if (a_folded != b_folded)
+                return std::int64_t(a_folded) - std::int64_t(b_folded);
+            ++i;
+            ++j;
+        }
+        else if constexpr (_unicode_cased<_char_t>)
+        {
+            auto a_decoded = _decode(a, a_size, i);
+            auto b_decoded = _decode(b, b_size, j);
+            // Ill-formed sequences are compared by their code units.
+            if (!a_decoded.valid || !b_decoded.valid)
+            {
+                for (std::size_t k = 0; k < std::min(a_decoded.length, b_decoded.length); ++k)
+                    if (a[i + k] != b[j + k])
+                        return std::int64_t(_code_unit(a[i + k])) - std::int64_t(_code_unit(b[j + k]));
+                if (a_decoded.length != b_decoded.length)
+                    return std::int64_t(a_decoded.length) - std::int64_t(b_decoded.length);
+            }
+            else
+            {
+                auto a_folded = _map_case<_case_mapping::fold>(a_decoded.code_point);
+                auto b_folded = _map_case<_case_mapping::fold>(b_decoded.code_point);
+                if (a_folded != b_folded)
+                    return std::int64_t(a_folded) - std::int64_t(b_folded);
+            }
+            i += a_decoded.length;
+            j += b_decoded.length;
+        }
+    }
+    return 0;
+}
+
+// Compares two views ignoring case, with the same result convention as `basic_string_view::compare`.
+// Only ASCII letters are folded, unless the character type is char8_t, char16_t or char32_t,
+// in which case every character is folded with the simple Unicode case folding.
+template <typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr std::make_signed_t<_size_t> icompare(basic_string_view<_char_t, _size_t, _traits_t> a, basic_string_view<_char_t, _size_t, _traits_t> b) noexcept
+{
+    std::size_t i = 0, j = 0;
+    if (auto comparison = _icompare_prefix(a.data(), a.size(), i, b.data(), b.size(), j))
+        return comparison < 0 ? -1 : 1;
+    return (a.size() - i != 0) - (b.size() - j != 0);
+}
+
+// Returns if two views are equal ignoring case.
+// Only ASCII letters are folded, unless the character type is char8_t, char16_t or char32_t,
+// in which case every character is folded with the simple Unicode case folding.
+template <typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr bool iequals(basic_string_view<_char_t, _size_t, _traits_t> a, basic_string_view<_char_t, _size_t, _traits_t> b) noexcept
+{
+    // Only Unicode folding can change the encoded length.
+    if (!_unicode_cased<_char_t> && a.size() != b.size())
+        return false;
+    std::size_t i = 0, j = 0;
+    return _icompare_prefix(a.data(), a.size(), i, b.data(), b.size(), j) == 0 && i == a.size() && j == b.size();
+}
+
+// Returns the offset of the first occurrence of `needle` in `haystack` at or after `offset`
+// ignoring case, or npos if there is none. Folds characters like `iequals`.
+template <typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr _size_t ifind(basic_string_view<_char_t, _size_t, _traits_t> haystack, basic_string_view<_char_t, _size_t, _traits_t> needle, _size_t offset = 0) noexcept
+{
+    const _char_t* data = haystack.data();
+    std::size_t size = haystack.size();
+    if (size < offset)
+        return haystack.npos;
+    if (needle.empty())
+        return offset;
+
+    // Only try positions whose first character could fold to the needle's.
+    std::uint32_t first = _map_ascii_case<_case_mapping::fold>(_code_unit(needle[0]));
+    bool first_ascii = !_unicode_cased<_char_t> || first < 0x80;
+    for (std::size_t i = offset; i < size;)
+    {
+        if !consteval
+        {
+            if (first_ascii)
+            {
+                // Non-ASCII characters may still fold to ASCII ones, e.g. the Kelvin sign.
+                i += _ascii_ifind_blocks<_unicode_cased<_char_t>>(data + i, size - i, first);
+                if (i == size)
+                    break;
+            }
+        }
+
+        std::size_t a = i, b = 0;
+        if (_icompare_prefix(data, size, a, needle.data(), needle.size(), b) == 0 && b == needle.size())
+            return static_cast<_size_t>(i);
+
+        // Move to the next character.
+        if constexpr (_unicode_cased<_char_t>)
+            i += _decode(data, size, i).length;
+        else
+            ++i;
+    }
+    return haystack.npos;
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "string.hpp"
+#include "string_simd.hpp"
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <new>
+
+// The integer types that can be parsed and formatted.
+template <typename _value_t>
+concept _integer = std::integral<_value_t> && !std::same_as<_value_t, bool>;
+
+// The result of parsing a value from the start of a view.
+template <typename _value_t, typename _size_t>
+struct parse_result
+{
+    _value_t value;
+    // The number of characters consumed, or 0 if no value could be parsed.
+    _size_t length;
+
+    // Returns if a value was parsed.
+    [[nodiscard]] explicit constexpr operator bool() const noexcept { return length != 0; }
+};
+
+inline constexpr std::uint64_t _powers_of_10[] =
+{
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+    10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull,
+    10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull,
+};
+
+inline constexpr char _digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+// Returns the number of decimal digits in the value.
+constexpr std::size_t _decimal_length(std::uint64_t value) noexcept
+{
+    value |= 1;
+    // 1233 / 4096 approximates log10(2).
+    std::size_t guess = (static_cast<std::size_t>(std::bit_width(value)) * 1233) >> 12;
+    return guess - (value < _powers_of_10[guess]) + 1;
+}
+
+// Writes the decimal digits of the value, two at a time, backwards from `end`.
+template <typename _char_t>
+constexpr void _write_decimal(_char_t* end, std::uint64_t value) noexcept
+{
+    while (value >= 100)
+    {
+        std::size_t pair = static_cast<std::size_t>(value % 100) * 2;
+        value /= 100;
+        *--end = _char_t(_digit_pairs[pair + 1]);
+        *--end = _char_t(_digit_pairs[pair]);
+    }
+    if (value >= 10)
+    {
+        *--end = _char_t(_digit_pairs[value * 2 + 1]);
+        *--end = _char_t(_digit_pairs[value * 2]);
+    }
+    else
+        *--end = _char_t('0' + value);
+}
+
+// Returns the value of a digit in any base up to 36, or 36 if the character isn't one.
+template <typename _char_t>
+constexpr unsigned _digit_value(_char_t element) noexcept
+{
+    auto unit = static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<_char_t>>(element));
+    if (unit - '0' < 10)
+        return unit - '0';
+    if ((unit | 0x20) - 'a' < 26)
+        return (unit | 0x20) - 'a' + 10;
+    return 36;
+}
+
+// Returns if the 8 bytes are all ASCII digits.
+constexpr bool _is_eight_digits(std::uint64_t word) noexcept
+{
+    return ((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// Returns the value of 8 ASCII digits loaded little-endian, combining pairs, then quads, then halves.
+constexpr std::uint32_t _parse_eight_digits(std::uint64_t word) noexcept
+{
+    word -= 0x3030303030303030ull;
+    word = word * 10 + (word >> 8);
+    word = ((word & 0x000000FF000000FFull) * 0x000F424000000064ull + ((word >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull) >> 32;
+    return static_cast<std::uint32_t>(word);
+}
+
+// Appends the decimal representation of the integer to the string.
+// The digits are written in place, so nothing is allocated if they fit in the small buffer.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout, _integer _value_t>
+constexpr void append_integer(basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string, _value_t value)
+{
+    using unsigned_type = std::make_unsigned_t<_value_t>;
+    bool negative = false;
+    if constexpr (std::is_signed_v<_value_t>)
+        negative = value < 0;
+    // Negating as unsigned handles the minimum value.
+    std::uint64_t magnitude = negative ? unsigned_type(0 - unsigned_type(value)) : unsigned_type(value);
+    std::size_t length = negative + _decimal_length(magnitude);
+    _append_overwrite(string, length, [negative, magnitude, length](_char_t* elements)
+    {
+        if (negative)
+            elements[0] = _char_t('-');
+        _write_decimal(elements + length, magnitude);
+    });
+}
+
+// Returns the decimal representation of the integer as a string.
+template <typename _string_t = string, _integer _value_t>
+[[nodiscard]] constexpr _string_t to_string(_value_t value)
+{
+    _string_t string;
+    append_integer(string, value);
+    return string;
+}
+
+// Parses an integer in the given base, from 2 to 36, from the start of the view.
+// Like std::from_chars, only a '-' sign for signed types and no prefixes are accepted.
+// Fails if there are no digits or if the value doesn't fit, consuming nothing.
+template <_integer _value_t, typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr parse_result<_value_t, _size_t> parse(basic_string_view<_char_t, _size_t, _traits_t> view, unsigned base = 10) noexcept
+{
+    using unsigned_type = std::make_unsigned_t<_value_t>;
+    const _char_t* data = view.data();
+    std::size_t size = view.size();
+    std::size_t i = 0;
+
+    bool negative = false;
+    if constexpr (std::is_signed_v<_value_t>)
+    {
+        negative = size != 0 && data[0] == _char_t('-');
+        i = negative;
+    }
+    std::size_t digits_begin = i;
+
+    std::uint64_t magnitude = 0;
+    bool overflow = false;
+    if constexpr (sizeof(_char_t) == 1 && std::endian::native == std::endian::little)
+    {
+        if !consteval
+        {
+            // Up to 19 digits can't overflow, so take 8 at a time while that holds.
+            while (base == 10 && size - i >= 8 && i - digits_begin <= 11 && _is_eight_digits(_load_word(data + i)))
+            {
+                magnitude = magnitude * 100000000 + _parse_eight_digits(_load_word(data + i));
+                i += 8;
+            }
+        }
+    }
+    for (unsigned digit; i < size && (digit = _digit_value(data[i])) < base; ++i)
+    {
+        if (magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / base)
+            overflow = true;
+        else
+            magnitude = magnitude * base + digit;
+    }
+
+    std::uint64_t limit = negative ? std::uint64_t(std::numeric_limits<_value_t>::max()) + 1 : std::numeric_limits<_value_t>::max();
+    if (i == digits_begin || overflow || limit < magnitude)
+        return { _value_t(), 0 };
+    auto value = negative ? _value_t(0 - unsigned_type(magnitude)) : _value_t(magnitude);
+    return { value, static_cast<_size_t>(i) };
+}
+
+// Parses an integer in the given base, from 2 to 36, from the start of the string.
+// Like std::from_chars, only a '-' sign for signed types and no prefixes are accepted.
+// Fails if there are no digits or if the value doesn't fit, consuming nothing.
+template <_integer _value_t, typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+[[nodiscard]] constexpr parse_result<_value_t, _size_t> parse(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string, unsigned base = 10) noexcept
+{
+    return parse<_value_t>(basic_string_view<_char_t, _size_t, _traits_t>(string), base);
+}
+
+// Returns the number of leading ASCII characters that can be part of a floating-point number, including infinity and NaN.
+template <typename _char_t>
+constexpr std::size_t _float_token_length(const _char_t* data, std::size_t size) noexcept
+{
+    std::size_t i = 0;
+    for (; i < size; ++i)
+    {
+        auto unit = static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<_char_t>>(data[i]));
+        if (_digit_value(data[i]) == 36 && unit != '.' && unit != '+' && unit != '-' && unit != '(' && unit != ')' && unit != '_')
+            break;
+    }
+    return i;
+}
+
+// Parses a plain decimal number whose digits fit in 19 digits and whose value is exactly
+// computed by one multiplication or division by a power of 10, as per Clinger.
+// Returns a length of 0 if the number is of another form, even if it's valid.
+template <std::floating_point _value_t, typename _char_t>
+constexpr parse_result<_value_t, std::size_t> _parse_float_fast(const _char_t* data, std::size_t size) noexcept
+{
+    constexpr int max_exponent = std::numeric_limits<_value_t>::digits == 53 ? 22 : std::numeric_limits<_value_t>::digits == 24 ? 10 : -1;
+    constexpr double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    if constexpr (max_exponent < 0)
+        return { _value_t(), 0 };
+    else
+    {
+        bool negative = size != 0 && data[0] == _char_t('-');
+        std::size_t i = negative;
+
+        std::uint64_t mantissa = 0;
+        std::size_t digits = 0;
+        int exponent = 0;
+        for (; i < size && _digit_value(data[i]) < 10; ++i, ++digits)
+            mantissa = mantissa * 10 + _digit_value(data[i]);
+        if (i < size && data[i] == _char_t('.'))
+            for (++i; i < size && _digit_value(data[i]) < 10; ++i, ++digits, --exponent)
+                mantissa = mantissa * 10 + _digit_value(data[i]);
+        if (digits == 0 || digits > 19)
+            return { _value_t(), 0 };
+
+        // An exponent is only consumed if it has digits.
+        if (i < size && (data[i] == _char_t('e') || data[i] == _char_t('E')))
+        {
+            std::size_t j = i + 1;
+            bool negative_exponent = j < size && data[j] == _char_t('-');
+            j += j < size && (data[j] == _char_t('-') || data[j] == _char_t('+'));
+            int explicit_exponent = 0;
+            std::size_t exponent_begin = j;
+            for (; j < size && _digit_value(data[j]) < 10 && explicit_exponent < 1000; ++j)
+                explicit_exponent = explicit_exponent * 10 + static_cast<int>(_digit_value(data[j]));
+            if (j < size && _digit_value(data[j]) < 10)
+                return { _value_t(), 0 };
+            if (j != exponent_begin)
+            {
+                exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+                i = j;
+            }
+        }
+        // Infinities, NaNs and hexadecimal digits are left to the general path.
+        if (i < size && _digit_value(data[i]) < 36)
+            return { _value_t(), 0 };
+
+        if (mantissa > (std::uint64_t(1) << std::numeric_limits<_value_t>::digits) || exponent < -max_exponent || max_exponent < exponent)
+            return { _value_t(), 0 };
+        auto value = static_cast<_value_t>(mantissa);
+        value = exponent < 0 ? value / static_cast<_value_t>(powers[-exponent]) : value * static_cast<_value_t>(powers[exponent]);
+        return { negative ? -value : value, i };
+    }
+}
+
+// Parses a floating-point number from the start of the view, without regard to the locale.
+// Like std::from_chars, accepts a '-' sign, decimal and exponent notation, infinity and NaN.
+// Fails if there is no number or if the value is out of range, consuming nothing.
+template <std::floating_point _value_t, typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] parse_result<_value_t, _size_t> parse(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    _value_t value;
+    if constexpr (std::same_as<_char_t, char>)
+    {
+        auto result = std::from_chars(view.data(), view.data() + view.size(), value);
+        if (result.ec != std::errc())
+            return { _value_t(), 0 };
+        return { value, static_cast<_size_t>(result.ptr - view.data()) };
+    }
+    else
+    {
+        if (auto fast = _parse_float_fast<_value_t>(view.data(), view.size()))
+            return { fast.value, static_cast<_size_t>(fast.length) };
+
+        // std::from_chars, which implements Eisel-Lemire, only takes char, so narrow the number first.
+        char small_buffer[64];
+        std::size_t size = _float_token_length(view.data(), view.size());
+        std::unique_ptr<char[]> large_buffer(size > sizeof(small_buffer) ? new (std::nothrow) char[size] : nullptr);
+        char* buffer = size > sizeof(small_buffer) ? large_buffer.get() : small_buffer;
+        if (buffer == nullptr)
+            return { _value_t(), 0 };
+        for (std::size_t i = 0; i < size; ++i)
+            buffer[i] = static_cast<char>(view.data()[i]);
+
+        auto result = std::from_chars(buffer, buffer + size, value);
+        if (result.ec != std::errc())
+            return { _value_t(), 0 };
+        return { value, static_cast<_size_t>(result.ptr - buffer) };
+    }
+}
+
+// Parses a floating-point number from the start of the string, without regard to the locale.
+// Like std::from_chars, accepts a '-' sign, decimal and exponent notation, infinity and NaN.
+// Fails if there is no number or if the value is out of range, consuming nothing.
+template <std::floating_point _value_t, typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+[[nodiscard]] parse_result<_value_t, _size_t> parse(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string) noexcept
+{
+    return parse<_value_t>(basic_string_view<_char_t, _size_t, _traits_t>(string));
+}
+
+// Appends the shortest representation of the value that parses back to it exactly.
+// Like std::to_chars, which implements Ryu, the shorter of fixed and scientific notation is used.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout, std::floating_point _value_t>
+void append_float(basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string, _value_t value)
+{
+    // Enough for any shortest long double, e.g. "-1.189731495357231765e-4932".
+    char buffer[48];
+    std::size_t length = static_cast<std::size_t>(std::to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer);
+    _append_overwrite(string, length, [&buffer, length](_char_t* elements)
+    {
+        for (std::size_t i = 0; i < length; ++i)
+            elements[i] = _char_t(buffer[i]);
+    });
+}
+
+// Returns the shortest representation of the value that parses back to it exactly.
+template <typename _string_t = string, std::floating_point _value_t>
+[[nodiscard]] _string_t to_string(_value_t value)
+{
+    _string_t string;
+    append_float(string, value);
+    return string;
+}
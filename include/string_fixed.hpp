@@ -0,0 +1,118 @@
+#pragma once
+
+#include "string_view.hpp"
+#include <compare>
+#include <cstddef>
+
+// A string whose length is part of its type, for strings built at compile time, of any length.
+// It's a structural type, so it can be a non-type template parameter, e.g. template <basic_fixed_string _key>.
+// The elements are public only because structural types require it.
+template <typename _char_t, std::size_t _size>
+struct basic_fixed_string
+{
+    using value_type = _char_t;
+    using size_type = std::size_t;
+    using const_pointer = const value_type*;
+    using const_iterator = const_pointer;
+
+    static constexpr value_type nult = value_type(); // Null Terminator
+
+    value_type elements[_size + 1]{};
+
+public:
+    [[nodiscard]] constexpr basic_fixed_string() noexcept = default;
+
+    // Copies a string literal, including its null terminator.
+    [[nodiscard]] constexpr basic_fixed_string(const value_type (&literal)[_size + 1]) noexcept
+    {
+        for (size_type i = 0; i < _size; ++i)
+            elements[i] = literal[i];
+    }
+
+public:
+    // Returns an immutable reference to the character at the given index in the string.
+    [[nodiscard]] constexpr const value_type& operator[](size_type index) const noexcept { return index < _size ? elements[index] : elements[_size]; }
+
+    // Returns a pointer to immutable elements.
+    [[nodiscard]] constexpr const_pointer data() const noexcept { return elements; }
+
+    // Returns a pointer to immutable elements.
+    [[nodiscard]] constexpr const_pointer c_str() const noexcept { return elements; }
+
+    // Returns if the string is empty.
+    [[nodiscard]] static constexpr bool empty() noexcept { return _size == 0; }
+
+    // Returns the length of the string.
+    [[nodiscard]] static constexpr size_type size() noexcept { return _size; }
+
+    // Returns the length of the string.
+    [[nodiscard]] static constexpr size_type length() noexcept { return _size; }
+
+    // Converts this string into a view of any size type and traits.
+    template <typename _size_t, typename _traits_t>
+    [[nodiscard]] constexpr operator basic_string_view<value_type, _size_t, _traits_t>() const noexcept
+    { return { elements, static_cast<_size_t>(_size) }; }
+
+    // Returns a view of this string.
+    [[nodiscard]] constexpr basic_string_view<value_type> view() const noexcept { return { elements, _size }; }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return elements; }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return elements + _size; }
+
+public:
+    // Concatenates two strings.
+    template <std::size_t _other_size>
+    [[nodiscard]] friend constexpr basic_fixed_string<value_type, _size + _other_size> operator+(
+        const basic_fixed_string& a,
+        const basic_fixed_string<value_type, _other_size>& b
+    ) noexcept
+    {
+        basic_fixed_string<value_type, _size + _other_size> result;
+        for (size_type i = 0; i < _size; ++i)
+            result.elements[i] = a.elements[i];
+        for (size_type i = 0; i < _other_size; ++i)
+            result.elements[_size + i] = b.elements[i];
+        return result;
+    }
+
+    // Concatenates a string and a string literal.
+    template <std::size_t _literal_size>
+    [[nodiscard]] friend constexpr auto operator+(const basic_fixed_string& a, const value_type (&b)[_literal_size]) noexcept
+    { return a + basic_fixed_string<value_type, _literal_size - 1>(b); }
+
+    // Concatenates a string literal and a string.
+    template <std::size_t _literal_size>
+    [[nodiscard]] friend constexpr auto operator+(const value_type (&a)[_literal_size], const basic_fixed_string& b) noexcept
+    { return basic_fixed_string<value_type, _literal_size - 1>(a) + b; }
+
+    // Compares two strings.
+    template <std::size_t _other_size>
+    [[nodiscard]] friend constexpr bool operator==(const basic_fixed_string& a, const basic_fixed_string<value_type, _other_size>& b) noexcept
+    { return a.view() == b.view(); }
+
+    // Compares two strings.
+    template <std::size_t _other_size>
+    [[nodiscard]] friend constexpr std::strong_ordering operator<=>(const basic_fixed_string& a, const basic_fixed_string<value_type, _other_size>& b) noexcept
+    { return a.view() <=> b.view(); }
+};
+
+template <typename _char_t, std::size_t _literal_size>
+basic_fixed_string(const _char_t (&)[_literal_size]) -> basic_fixed_string<_char_t, _literal_size - 1>;
+
+template <std::size_t _size> using fixed_string = basic_fixed_string<char, _size>;
+template <std::size_t _size> using fixed_u8string = basic_fixed_string<char8_t, _size>;
+template <std::size_t _size> using fixed_u16string = basic_fixed_string<char16_t, _size>;
+template <std::size_t _size> using fixed_u32string = basic_fixed_string<char32_t, _size>;
+template <std::size_t _size> using fixed_wstring = basic_fixed_string<wchar_t, _size>;
+
+inline namespace string_literals
+{
+    // Returns the literal as a fixed string, e.g. "config"_fs + "/" + "keys"_fs.
+    template <basic_fixed_string _string>
+    [[nodiscard]] consteval auto operator""_fs() noexcept { return _string; }
+
+    // Returns a view of the literal, pointing into static storage that's shared by every use of the same literal.
+    // Its length is computed at compile time, instead of with traits_type::length.
+    template <basic_fixed_string _string>
+    [[nodiscard]] consteval auto operator""_sv() noexcept { return _string.view(); }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "string.hpp"
+#include <iterator>
+#include <version>
+
+// An output iterator that appends to a string, writing into its spare capacity and growing it geometrically.
+template <typename _string_t>
+class basic_string_appender
+{
+public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+public:
+    [[nodiscard]] explicit constexpr basic_string_appender(_string_t& string) noexcept
+        : _string(std::addressof(string)) {}
+
+    constexpr basic_string_appender& operator=(typename _string_t::value_type element)
+    {
+        _append_overwrite(*_string, 1, [element](auto* elements) { *elements = element; });
+        return *this;
+    }
+
+    [[nodiscard]] constexpr basic_string_appender& operator*() noexcept { return *this; }
+    constexpr basic_string_appender& operator++() noexcept { return *this; }
+    constexpr basic_string_appender operator++(int) noexcept { return *this; }
+
+private:
+    _string_t* _string;
+};
+
+// std::format support, for standard libraries that have it.
+#if __cpp_lib_format
+
+#include <concepts>
+#include <format>
+#include <type_traits>
+
+// The character types std::format has contexts for.
+template <typename _char_t>
+concept _format_char = std::same_as<_char_t, char> || std::same_as<_char_t, wchar_t>;
+
+// Formats a view like a std::basic_string_view, honoring the fill, alignment, width and precision.
+template <_format_char _char_t, typename _size_t, typename _traits_t>
+struct std::formatter<::basic_string_view<_char_t, _size_t, _traits_t>, _char_t> : std::formatter<std::basic_string_view<_char_t>, _char_t>
+{
+    template <typename _context_t>
+    auto format(::basic_string_view<_char_t, _size_t, _traits_t> view, _context_t& context) const
+    {
+        return std::formatter<std::basic_string_view<_char_t>, _char_t>::format(std::basic_string_view<_char_t>(view.data(), view.size()), context);
+    }
+};
+
+// Formats a string like a std::basic_string, honoring the fill, alignment, width and precision.
+template <_format_char _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+struct std::formatter<::basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>, _char_t>
+    : std::formatter<::basic_string_view<_char_t, _size_t, _traits_t>, _char_t>
+{
+    template <typename _context_t>
+    auto format(const ::basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string, _context_t& context) const
+    {
+        return std::formatter<::basic_string_view<_char_t, _size_t, _traits_t>, _char_t>::format(string, context);
+    }
+};
+
+// The std::format context type for a character type.
+template <_format_char _char_t>
+using _format_context = std::conditional_t<std::is_same_v<_char_t, char>, std::format_context, std::wformat_context>;
+
+// Appends the formatted arguments to the string, without going through a temporary std::basic_string.
+// Named apart from std::format_to, which argument-dependent lookup would otherwise make ambiguous.
+template <_format_char _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout, typename... _args_t>
+void format_into(
+    basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string,
+    std::basic_format_string<std::type_identity_t<_char_t>, std::type_identity_t<_args_t>...> pattern,
+    _args_t&&... args
+)
+{
+    std::vformat_to(basic_string_appender(string), pattern.get(), std::make_format_args<_format_context<_char_t>>(args...));
+}
+
+// Returns a string holding the formatted arguments.
+// Named apart from std::format, which argument-dependent lookup would otherwise make ambiguous.
+template <typename _string_t = string, typename... _args_t>
+    requires _format_char<typename _string_t::value_type>
+[[nodiscard]] _string_t format_string(std::basic_format_string<typename _string_t::value_type, std::type_identity_t<_args_t>...> pattern, _args_t&&... args)
+{
+    _string_t string;
+    std::vformat_to(basic_string_appender(string), pattern.get(), std::make_format_args<_format_context<typename _string_t::value_type>>(args...));
+    return string;
+}
+
+#endif
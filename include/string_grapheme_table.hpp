@@ -0,0 +1,145 @@
+#pragma once
+
+// Generated by tools/generate_grapheme_table.pl from Unicode 14.0.0. Do not edit.
+
+#include <cstdint>
+
+// Grapheme_Cluster_Break property values, with Extended_Pictographic folded in.
+enum class _grapheme_category : std::uint8_t
+{
+    other, cr, lf, control, extend, zwj, regional_indicator, prepend,
+    spacing_mark, l, v, t, lv, lvt, extended_pictographic,
+};
+
+// Each entry is the first code point of a run, shifted left by 8, or'd with the category of the run.
+inline constexpr std::uint32_t _grapheme_table[] =
+{
+    0x00000000, 0x00008003, 0x0000A000, 0x0000A90E, 0x0000AA00, 0x0000AD03, 0x0000AE0E, 0x0000AF00,
+    0x00030004, 0x00037000, 0x00048304, 0x00048A00, 0x00059104, 0x0005BE00, 0x0005BF04, 0x0005C000,
+    0x0005C104, 0x0005C300, 0x0005C404, 0x0005C600, 0x0005C704, 0x0005C800, 0x00060007, 0x00060600,
+    0x00061004, 0x00061B00, 0x00061C03, 0x00061D00, 0x00064B04, 0x00066000, 0x00067004, 0x00067100,
+    0x0006D604, 0x0006DD07, 0x0006DE00, 0x0006DF04, 0x0006E500, 0x0006E704, 0x0006E900, 0x0006EA04,
+    0x0006EE00, 0x00070F07, 0x00071000, 0x00071104, 0x00071200, 0x00073004, 0x00074B00, 0x0007A604,
+    0x0007B100, 0x0007EB04, 0x0007F400, 0x0007FD04, 0x0007FE00, 0x00081604, 0x00081A00, 0x00081B04,
+    0x00082400, 0x00082504, 0x00082800, 0x00082904, 0x00082E00, 0x00085904, 0x00085C00, 0x00089007,
+    0x00089200, 0x00089804, 0x0008A000, 0x0008CA04, 0x0008E207, 0x0008E304, 0x00090308, 0x00090400,
+    0x00093A04, 0x00093B08, 0x00093C04, 0x00093D00, 0x00093E08, 0x00094104, 0x00094908, 0x00094D04,
+    0x00094E08, 0x00095000, 0x00095104, 0x00095800, 0x00096204, 0x00096400, 0x00098104, 0x00098208,
+    0x00098400, 0x0009BC04, 0x0009BD00, 0x0009BE04, 0x0009BF08, 0x0009C104, 0x0009C500, 0x0009C708,
+    0x0009C900, 0x0009CB08, 0x0009CD04, 0x0009CE00, 0x0009D704, 0x0009D800, 0x0009E204, 0x0009E400,
+    0x0009FE04, 0x0009FF00, 0x000A0104, 0x000A0308, 0x000A0400, 0x000A3C04, 0x000A3D00, 0x000A3E08,
+    0x000A4104, 0x000A4300, 0x000A4704, 0x000A4900, 0x000A4B04, 0x000A4E00, 0x000A5104, 0x000A5200,
+    0x000A7004, 0x000A7200, 0x000A7504, 0x000A7600, 0x000A8104, 0x000A8308, 0x000A8400, 0x000ABC04,
+    0x000ABD00, 0x000ABE08, 0x000AC104, 0x000AC600, 0x000AC704, 0x000AC908, 0x000ACA00, 0x000ACB08,
+    0x000ACD04, 0x000ACE00, 0x000AE204, 0x000AE400, 0x000AFA04, 0x000B0000, 0x000B0104, 0x000B0208,
+    0x000B0400, 0x000B3C04, 0x000B3D00, 0x000B3E04, 0x000B4008, 0x000B4104, 0x000B4500, 0x000B4708,
+    0x000B4900, 0x000B4B08, 0x000B4D04, 0x000B4E00, 0x000B5504, 0x000B5800, 0x000B6204, 0x000B6400,
+    0x000B8204, 0x000B8300, 0x000BBE04, 0x000BBF08, 0x000BC004, 0x000BC108, 0x000BC300, 0x000BC608,
+    0x000BC900, 0x000BCA08, 0x000BCD04, 0x000BCE00, 0x000BD704, 0x000BD800, 0x000C0004, 0x000C0108,
+    0x000C0404, 0x000C0500, 0x000C3C04, 0x000C3D00, 0x000C3E04, 0x000C4108, 0x000C4500, 0x000C4604,
+    0x000C4900, 0x000C4A04, 0x000C4E00, 0x000C5504, 0x000C5700, 0x000C6204, 0x000C6400, 0x000C8104,
+    0x000C8208, 0x000C8400, 0x000CBC04, 0x000CBD00, 0x000CBE08, 0x000CBF04, 0x000CC008, 0x000CC204,
+    0x000CC308, 0x000CC500, 0x000CC604, 0x000CC708, 0x000CC900, 0x000CCA08, 0x000CCC04, 0x000CCE00,
+    0x000CD504, 0x000CD700, 0x000CE204, 0x000CE400, 0x000D0004, 0x000D0208, 0x000D0400, 0x000D3B04,
+    0x000D3D00, 0x000D3E04, 0x000D3F08, 0x000D4104, 0x000D4500, 0x000D4608, 0x000D4900, 0x000D4A08,
+    0x000D4D04, 0x000D4E07, 0x000D4F00, 0x000D5704, 0x000D5800, 0x000D6204, 0x000D6400, 0x000D8104,
+    0x000D8208, 0x000D8400, 0x000DCA04, 0x000DCB00, 0x000DCF04, 0x000DD008, 0x000DD204, 0x000DD500,
+    0x000DD604, 0x000DD700, 0x000DD808, 0x000DDF04, 0x000DE000, 0x000DF208, 0x000DF400, 0x000E3104,
+    0x000E3200, 0x000E3308, 0x000E3404, 0x000E3B00, 0x000E4704, 0x000E4F00, 0x000EB104, 0x000EB200,
+    0x000EB308, 0x000EB404, 0x000EBD00, 0x000EC804, 0x000ECE00, 0x000F1804, 0x000F1A00, 0x000F3504,
+    0x000F3600, 0x000F3704, 0x000F3800, 0x000F3904, 0x000F3A00, 0x000F3E08, 0x000F4000, 0x000F7104,
+    0x000F7F08, 0x000F8004, 0x000F8500, 0x000F8604, 0x000F8800, 0x000F8D04, 0x000F9800, 0x000F9904,
+    0x000FBD00, 0x000FC604, 0x000FC700, 0x00102D04, 0x00103108, 0x00103204, 0x00103800, 0x00103904,
+    0x00103B08, 0x00103D04, 0x00103F00, 0x00105608, 0x00105804, 0x00105A00, 0x00105E04, 0x00106100,
+    0x00107104, 0x00107500, 0x00108204, 0x00108300, 0x00108408, 0x00108504, 0x00108700, 0x00108D04,
+    0x00108E00, 0x00109D04, 0x00109E00, 0x00110009, 0x0011600A, 0x0011A80B, 0x00120000, 0x00135D04,
+    0x00136000, 0x00171204, 0x00171508, 0x00171600, 0x00173204, 0x00173408, 0x00173500, 0x00175204,
+    0x00175400, 0x00177204, 0x00177400, 0x0017B404, 0x0017B608, 0x0017B704, 0x0017BE08, 0x0017C604,
+    0x0017C708, 0x0017C904, 0x0017D400, 0x0017DD04, 0x0017DE00, 0x00180B04, 0x00180E03, 0x00180F04,
+    0x00181000, 0x00188504, 0x00188700, 0x0018A904, 0x0018AA00, 0x00192004, 0x00192308, 0x00192704,
+    0x00192908, 0x00192C00, 0x00193008, 0x00193204, 0x00193308, 0x00193904, 0x00193C00, 0x001A1704,
+    0x001A1908, 0x001A1B04, 0x001A1C00, 0x001A5508, 0x001A5604, 0x001A5708, 0x001A5804, 0x001A5F00,
+    0x001A6004, 0x001A6100, 0x001A6204, 0x001A6300, 0x001A6504, 0x001A6D08, 0x001A7304, 0x001A7D00,
+    0x001A7F04, 0x001A8000, 0x001AB004, 0x001ACF00, 0x001B0004, 0x001B0408, 0x001B0500, 0x001B3404,
+    0x001B3B08, 0x001B3C04, 0x001B3D08, 0x001B4204, 0x001B4308, 0x001B4500, 0x001B6B04, 0x001B7400,
+    0x001B8004, 0x001B8208, 0x001B8300, 0x001BA108, 0x001BA204, 0x001BA608, 0x001BA804, 0x001BAA08,
+    0x001BAB04, 0x001BAE00, 0x001BE604, 0x001BE708, 0x001BE804, 0x001BEA08, 0x001BED04, 0x001BEE08,
+    0x001BEF04, 0x001BF208, 0x001BF400, 0x001C2408, 0x001C2C04, 0x001C3408, 0x001C3604, 0x001C3800,
+    0x001CD004, 0x001CD300, 0x001CD404, 0x001CE108, 0x001CE204, 0x001CE900, 0x001CED04, 0x001CEE00,
+    0x001CF404, 0x001CF500, 0x001CF708, 0x001CF804, 0x001CFA00, 0x001DC004, 0x001E0000, 0x00200B03,
+    0x00200C04, 0x00200D05, 0x00200E03, 0x00201000, 0x00202803, 0x00202F00, 0x00203C0E, 0x00203D00,
+    0x0020490E, 0x00204A00, 0x00206003, 0x00207000, 0x0020D004, 0x0020F100, 0x0021220E, 0x00212300,
+    0x0021390E, 0x00213A00, 0x0021940E, 0x00219A00, 0x0021A90E, 0x0021AB00, 0x00231A0E, 0x00231C00,
+    0x0023280E, 0x00232900, 0x0023880E, 0x00238900, 0x0023CF0E, 0x0023D000, 0x0023E90E, 0x0023F400,
+    0x0023F80E, 0x0023FB00, 0x0024C20E, 0x0024C300, 0x0025AA0E, 0x0025AC00, 0x0025B60E, 0x0025B700,
+    0x0025C00E, 0x0025C100, 0x0025FB0E, 0x0025FF00, 0x0026000E, 0x00260600, 0x0026070E, 0x00261300,
+    0x0026140E, 0x00268600, 0x0026900E, 0x00270600, 0x0027080E, 0x00271300, 0x0027140E, 0x00271500,
+    0x0027160E, 0x00271700, 0x00271D0E, 0x00271E00, 0x0027210E, 0x00272200, 0x0027280E, 0x00272900,
+    0x0027330E, 0x00273500, 0x0027440E, 0x00274500, 0x0027470E, 0x00274800, 0x00274C0E, 0x00274D00,
+    0x00274E0E, 0x00274F00, 0x0027530E, 0x00275600, 0x0027570E, 0x00275800, 0x0027630E, 0x00276800,
+    0x0027950E, 0x00279800, 0x0027A10E, 0x0027A200, 0x0027B00E, 0x0027B100, 0x0027BF0E, 0x0027C000,
+    0x0029340E, 0x00293600, 0x002B050E, 0x002B0800, 0x002B1B0E, 0x002B1D00, 0x002B500E, 0x002B5100,
+    0x002B550E, 0x002B5600, 0x002CEF04, 0x002CF200, 0x002D7F04, 0x002D8000, 0x002DE004, 0x002E0000,
+    0x00302A04, 0x0030300E, 0x00303100, 0x00303D0E, 0x00303E00, 0x00309904, 0x00309B00, 0x0032970E,
+    0x00329800, 0x0032990E, 0x00329A00, 0x00A66F04, 0x00A67300, 0x00A67404, 0x00A67E00, 0x00A69E04,
+    0x00A6A000, 0x00A6F004, 0x00A6F200, 0x00A80204, 0x00A80300, 0x00A80604, 0x00A80700, 0x00A80B04,
+    0x00A80C00, 0x00A82308, 0x00A82504, 0x00A82708, 0x00A82800, 0x00A82C04, 0x00A82D00, 0x00A88008,
+    0x00A88200, 0x00A8B408, 0x00A8C404, 0x00A8C600, 0x00A8E004, 0x00A8F200, 0x00A8FF04, 0x00A90000,
+    0x00A92604, 0x00A92E00, 0x00A94704, 0x00A95208, 0x00A95400, 0x00A96009, 0x00A97D00, 0x00A98004,
+    0x00A98308, 0x00A98400, 0x00A9B304, 0x00A9B408, 0x00A9B604, 0x00A9BA08, 0x00A9BC04, 0x00A9BE08,
+    0x00A9C100, 0x00A9E504, 0x00A9E600, 0x00AA2904, 0x00AA2F08, 0x00AA3104, 0x00AA3308, 0x00AA3504,
+    0x00AA3700, 0x00AA4304, 0x00AA4400, 0x00AA4C04, 0x00AA4D08, 0x00AA4E00, 0x00AA7C04, 0x00AA7D00,
+    0x00AAB004, 0x00AAB100, 0x00AAB204, 0x00AAB500, 0x00AAB704, 0x00AAB900, 0x00AABE04, 0x00AAC000,
+    0x00AAC104, 0x00AAC200, 0x00AAEB08, 0x00AAEC04, 0x00AAEE08, 0x00AAF000, 0x00AAF508, 0x00AAF604,
+    0x00AAF700, 0x00ABE308, 0x00ABE504, 0x00ABE608, 0x00ABE804, 0x00ABE908, 0x00ABEB00, 0x00ABEC08,
+    0x00ABED04, 0x00ABEE00, 0x00D7B00A, 0x00D7C700, 0x00D7CB0B, 0x00D7FC00, 0x00FB1E04, 0x00FB1F00,
+    0x00FE0004, 0x00FE1000, 0x00FE2004, 0x00FE3000, 0x00FEFF03, 0x00FF0000, 0x00FF9E04, 0x00FFA000,
+    0x00FFF003, 0x00FFFC00, 0x0101FD04, 0x0101FE00, 0x0102E004, 0x0102E100, 0x01037604, 0x01037B00,
+    0x010A0104, 0x010A0400, 0x010A0504, 0x010A0700, 0x010A0C04, 0x010A1000, 0x010A3804, 0x010A3B00,
+    0x010A3F04, 0x010A4000, 0x010AE504, 0x010AE700, 0x010D2404, 0x010D2800, 0x010EAB04, 0x010EAD00,
+    0x010F4604, 0x010F5100, 0x010F8204, 0x010F8600, 0x01100008, 0x01100104, 0x01100208, 0x01100300,
+    0x01103804, 0x01104700, 0x01107004, 0x01107100, 0x01107304, 0x01107500, 0x01107F04, 0x01108208,
+    0x01108300, 0x0110B008, 0x0110B304, 0x0110B708, 0x0110B904, 0x0110BB00, 0x0110BD07, 0x0110BE00,
+    0x0110C204, 0x0110C300, 0x0110CD07, 0x0110CE00, 0x01110004, 0x01110300, 0x01112704, 0x01112C08,
+    0x01112D04, 0x01113500, 0x01114508, 0x01114700, 0x01117304, 0x01117400, 0x01118004, 0x01118208,
+    0x01118300, 0x0111B308, 0x0111B604, 0x0111BF08, 0x0111C100, 0x0111C207, 0x0111C400, 0x0111C904,
+    0x0111CD00, 0x0111CE08, 0x0111CF04, 0x0111D000, 0x01122C08, 0x01122F04, 0x01123208, 0x01123404,
+    0x01123508, 0x01123604, 0x01123800, 0x01123E04, 0x01123F00, 0x0112DF04, 0x0112E008, 0x0112E304,
+    0x0112EB00, 0x01130004, 0x01130208, 0x01130400, 0x01133B04, 0x01133D00, 0x01133E04, 0x01133F08,
+    0x01134004, 0x01134108, 0x01134500, 0x01134708, 0x01134900, 0x01134B08, 0x01134E00, 0x01135704,
+    0x01135800, 0x01136208, 0x01136400, 0x01136604, 0x01136D00, 0x01137004, 0x01137500, 0x01143508,
+    0x01143804, 0x01144008, 0x01144204, 0x01144508, 0x01144604, 0x01144700, 0x01145E04, 0x01145F00,
+    0x0114B004, 0x0114B108, 0x0114B304, 0x0114B908, 0x0114BA04, 0x0114BB08, 0x0114BD04, 0x0114BE08,
+    0x0114BF04, 0x0114C108, 0x0114C204, 0x0114C400, 0x0115AF04, 0x0115B008, 0x0115B204, 0x0115B600,
+    0x0115B808, 0x0115BC04, 0x0115BE08, 0x0115BF04, 0x0115C100, 0x0115DC04, 0x0115DE00, 0x01163008,
+    0x01163304, 0x01163B08, 0x01163D04, 0x01163E08, 0x01163F04, 0x01164100, 0x0116AB04, 0x0116AC08,
+    0x0116AD04, 0x0116AE08, 0x0116B004, 0x0116B608, 0x0116B704, 0x0116B800, 0x01171D04, 0x01172000,
+    0x01172204, 0x01172608, 0x01172704, 0x01172C00, 0x01182C08, 0x01182F04, 0x01183808, 0x01183904,
+    0x01183B00, 0x01193004, 0x01193108, 0x01193600, 0x01193708, 0x01193900, 0x01193B04, 0x01193D08,
+    0x01193E04, 0x01193F07, 0x01194008, 0x01194107, 0x01194208, 0x01194304, 0x01194400, 0x0119D108,
+    0x0119D404, 0x0119D800, 0x0119DA04, 0x0119DC08, 0x0119E004, 0x0119E100, 0x0119E408, 0x0119E500,
+    0x011A0104, 0x011A0B00, 0x011A3304, 0x011A3908, 0x011A3A07, 0x011A3B04, 0x011A3F00, 0x011A4704,
+    0x011A4800, 0x011A5104, 0x011A5708, 0x011A5904, 0x011A5C00, 0x011A8407, 0x011A8A04, 0x011A9708,
+    0x011A9804, 0x011A9A00, 0x011C2F08, 0x011C3004, 0x011C3700, 0x011C3804, 0x011C3E08, 0x011C3F04,
+    0x011C4000, 0x011C9204, 0x011CA800, 0x011CA908, 0x011CAA04, 0x011CB108, 0x011CB204, 0x011CB408,
+    0x011CB504, 0x011CB700, 0x011D3104, 0x011D3700, 0x011D3A04, 0x011D3B00, 0x011D3C04, 0x011D3E00,
+    0x011D3F04, 0x011D4607, 0x011D4704, 0x011D4800, 0x011D8A08, 0x011D8F00, 0x011D9004, 0x011D9200,
+    0x011D9308, 0x011D9504, 0x011D9608, 0x011D9704, 0x011D9800, 0x011EF304, 0x011EF508, 0x011EF700,
+    0x01343003, 0x01343900, 0x016AF004, 0x016AF500, 0x016B3004, 0x016B3700, 0x016F4F04, 0x016F5000,
+    0x016F5108, 0x016F8800, 0x016F8F04, 0x016F9300, 0x016FE404, 0x016FE500, 0x016FF008, 0x016FF200,
+    0x01BC9D04, 0x01BC9F00, 0x01BCA003, 0x01BCA400, 0x01CF0004, 0x01CF2E00, 0x01CF3004, 0x01CF4700,
+    0x01D16504, 0x01D16608, 0x01D16704, 0x01D16A00, 0x01D16D08, 0x01D16E04, 0x01D17303, 0x01D17B04,
+    0x01D18300, 0x01D18504, 0x01D18C00, 0x01D1AA04, 0x01D1AE00, 0x01D24204, 0x01D24500, 0x01DA0004,
+    0x01DA3700, 0x01DA3B04, 0x01DA6D00, 0x01DA7504, 0x01DA7600, 0x01DA8404, 0x01DA8500, 0x01DA9B04,
+    0x01DAA000, 0x01DAA104, 0x01DAB000, 0x01E00004, 0x01E00700, 0x01E00804, 0x01E01900, 0x01E01B04,
+    0x01E02200, 0x01E02304, 0x01E02500, 0x01E02604, 0x01E02B00, 0x01E13004, 0x01E13700, 0x01E2AE04,
+    0x01E2AF00, 0x01E2EC04, 0x01E2F000, 0x01E8D004, 0x01E8D700, 0x01E94404, 0x01E94B00, 0x01F0000E,
+    0x01F10000, 0x01F10D0E, 0x01F11000, 0x01F12F0E, 0x01F13000, 0x01F16C0E, 0x01F17200, 0x01F17E0E,
+    0x01F18000, 0x01F18E0E, 0x01F18F00, 0x01F1910E, 0x01F19B00, 0x01F1AD0E, 0x01F1E606, 0x01F20000,
+    0x01F2010E, 0x01F21000, 0x01F21A0E, 0x01F21B00, 0x01F22F0E, 0x01F23000, 0x01F2320E, 0x01F23B00,
+    0x01F23C0E, 0x01F24000, 0x01F2490E, 0x01F3FB04, 0x01F4000E, 0x01F53E00, 0x01F5460E, 0x01F65000,
+    0x01F6800E, 0x01F70000, 0x01F7740E, 0x01F78000, 0x01F7D50E, 0x01F80000, 0x01F80C0E, 0x01F81000,
+    0x01F8480E, 0x01F85000, 0x01F85A0E, 0x01F86000, 0x01F8880E, 0x01F89000, 0x01F8AE0E, 0x01F90000,
+    0x01F90C0E, 0x01F93B00, 0x01F93C0E, 0x01F94600, 0x01F9470E, 0x01FB0000, 0x01FC000E, 0x01FFFE00,
+    0x0E000003, 0x0E002004, 0x0E008003, 0x0E010004, 0x0E01F003, 0x0E100000,
+};
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "string_grapheme_table.hpp"
+#include "string_unicode.hpp"
+#include <algorithm>
+
+// Returns the Grapheme_Cluster_Break category of a code point.
+constexpr _grapheme_category _grapheme_category_of(char32_t code_point) noexcept
+{
+    if (code_point < 0x80)
+    {
+        if (code_point == U'\r')
+            return _grapheme_category::cr;
+        if (code_point == U'\n')
+            return _grapheme_category::lf;
+        return code_point < 0x20 || code_point == 0x7F ? _grapheme_category::control : _grapheme_category::other;
+    }
+    // Hangul syllables alternate between LV and LVT, so they are computed instead of stored.
+    if (0xAC00 <= code_point && code_point <= 0xD7A3)
+        return (code_point - 0xAC00) % 28 == 0 ? _grapheme_category::lv : _grapheme_category::lvt;
+
+    // Find the last run starting at or before the code point.
+    auto run = std::upper_bound(std::begin(_grapheme_table), std::end(_grapheme_table), (std::uint32_t(code_point) << 8) | 0xFF);
+    return static_cast<_grapheme_category>(run[-1] & 0xFF);
+}
+
+// What precedes a potential boundary, beyond the category right before it.
+struct _grapheme_state
+{
+    // Extended_Pictographic Extend*, optionally followed by ZWJ, for GB11.
+    enum : std::uint8_t { none, pictographic, pictographic_zwj } emoji = none;
+    // The number of consecutive regional indicators, for GB12 and GB13.
+    std::size_t regional_indicators = 0;
+
+    constexpr void update(_grapheme_category category) noexcept
+    {
+        using enum _grapheme_category;
+        if (category == extended_pictographic || (category == extend && emoji == pictographic))
+            emoji = pictographic;
+        else if (category == zwj && emoji == pictographic)
+            emoji = pictographic_zwj;
+        else
+            emoji = none;
+        regional_indicators = category == regional_indicator ? regional_indicators + 1 : 0;
+    }
+};
+
+// Returns if there is an extended grapheme cluster boundary between the two categories, as per UAX #29.
+constexpr bool _is_grapheme_boundary(_grapheme_category before, _grapheme_category after, const _grapheme_state& state) noexcept
+{
+    using enum _grapheme_category;
+    if (before == cr && after == lf) // GB3
+        return false;
+    if (before == control || before == cr || before == lf) // GB4
+        return true;
+    if (after == control || after == cr || after == lf) // GB5
+        return true;
+    if (before == l && (after == l || after == v || after == lv || after == lvt)) // GB6
+        return false;
+    if ((before == lv || before == v) && (after == v || after == t)) // GB7
+        return false;
+    if ((before == lvt || before == t) && after == t) // GB8
+        return false;
+    if (after == extend || after == zwj || after == spacing_mark) // GB9, GB9a
+        return false;
+    if (before == prepend) // GB9b
+        return false;
+    if (state.emoji == _grapheme_state::pictographic_zwj && after == extended_pictographic) // GB11
+        return false;
+    if (after == regional_indicator && state.regional_indicators % 2 == 1) // GB12, GB13
+        return false;
+    return true; // GB999
+}
+
+// A lazy range over the extended grapheme clusters of a view, each yielded as a view.
+template <_unicode_char _char_t, typename _size_t, typename _traits_t>
+class basic_grapheme_view : public std::ranges::view_interface<basic_grapheme_view<_char_t, _size_t, _traits_t>>
+{
+public:
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+    using size_type = _size_t;
+
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = string_view_type;
+        using difference_type = std::ptrdiff_t;
+
+    public:
+        [[nodiscard]] constexpr iterator() noexcept = default;
+
+        [[nodiscard]] constexpr string_view_type operator*() const noexcept
+        { return { _data + _begin, static_cast<size_type>(_end - _begin) }; }
+
+        constexpr iterator& operator++() noexcept
+        {
+            _begin = _end;
+            _find_end();
+            return *this;
+        }
+
+        constexpr iterator operator++(int) noexcept
+        {
+            iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const iterator& other) const noexcept { return _begin == other._begin; }
+
+        // Returns the offset of the first code unit of the current cluster.
+        [[nodiscard]] constexpr size_type offset() const noexcept { return static_cast<size_type>(_begin); }
+
+    private:
+        friend class basic_grapheme_view;
+
+        [[nodiscard]] constexpr iterator(const _char_t* data, std::size_t size, std::size_t begin) noexcept
+            : _data(data), _size(size), _begin(begin), _end(begin)
+        {
+            _find_end();
+        }
+
+        constexpr void _find_end() noexcept
+        {
+            if (_begin >= _size)
+                return;
+            if !consteval
+            {
+                // Two ASCII characters are always separated by a boundary, unless they are CR LF.
+                if (_ascii_end <= _begin && _code_unit(_data[_begin]) < 0x80)
+                    _ascii_end = _begin + _ascii_prefix_length(_data + _begin, _size - _begin);
+                if (_begin + 1 < _ascii_end && _data[_begin] != _char_t('\r'))
+                {
+                    _end = _begin + 1;
+                    return;
+                }
+            }
+
+            auto decoded = _decode(_data, _size, _begin);
+            auto before = _grapheme_category_of(decoded.code_point);
+            _grapheme_state state;
+            state.update(before);
+            _end = _begin + decoded.length;
+            while (_end < _size)
+            {
+                decoded = _decode(_data, _size, _end);
+                auto after = _grapheme_category_of(decoded.code_point);
+                if (_is_grapheme_boundary(before, after, state))
+                    break;
+                state.update(after);
+                before = after;
+                _end += decoded.length;
+            }
+        }
+
+    private:
+        const _char_t* _data = nullptr;
+        std::size_t _size = 0;
+        std::size_t _begin = 0;
+        std::size_t _end = 0;
+        // The end of the ASCII run last found by the vectorized scan.
+        std::size_t _ascii_end = 0;
+    };
+
+public:
+    [[nodiscard]] constexpr basic_grapheme_view() noexcept = default;
+
+    [[nodiscard]] explicit constexpr basic_grapheme_view(string_view_type view) noexcept
+        : _view(view) {}
+
+    [[nodiscard]] constexpr iterator begin() const noexcept { return { _view.data(), _view.size(), 0 }; }
+    [[nodiscard]] constexpr iterator end() const noexcept { return { _view.data(), _view.size(), _view.size() }; }
+
+    // Returns the underlying view.
+    [[nodiscard]] constexpr string_view_type base() const noexcept { return _view; }
+
+private:
+    string_view_type _view;
+};
+
+// Returns a lazy range over the extended grapheme clusters of the view.
+template <_unicode_char _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr basic_grapheme_view<_char_t, _size_t, _traits_t> graphemes(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    return basic_grapheme_view<_char_t, _size_t, _traits_t>(view);
+}
+
+// Returns a lazy range over the extended grapheme clusters of the string.
+template <_unicode_char _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+[[nodiscard]] constexpr basic_grapheme_view<_char_t, _size_t, _traits_t> graphemes(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string) noexcept
+{
+    return basic_grapheme_view<_char_t, _size_t, _traits_t>(string);
+}
+
+// Returns the longest prefix of the view holding at most `count` extended grapheme clusters.
+template <_unicode_char _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr basic_string_view<_char_t, _size_t, _traits_t> truncate_graphemes(basic_string_view<_char_t, _size_t, _traits_t> view, std::size_t count) noexcept
+{
+    auto clusters = graphemes(view);
+    auto it = clusters.begin();
+    for (; count != 0 && it != clusters.end(); --count)
+        ++it;
+    return view.substr(0, it.offset());
+}
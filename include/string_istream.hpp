@@ -0,0 +1,139 @@
+#pragma once
+
+#include "string.hpp"
+#include <istream>
+#include <locale>
+
+// Grows the string's capacity geometrically, by at least what the stream buffer already holds.
+// Returns false if the string is already at its max size.
+template <typename _string_t, typename _istream_t>
+bool _grow_for_extraction(_string_t& string, _istream_t& istream)
+{
+    std::size_t size = string.size();
+    if (size == string.max_size())
+        return false;
+    std::streamsize available = istream.rdbuf()->in_avail();
+    std::size_t wanted = size + std::max<std::size_t>(available > 0 ? static_cast<std::size_t>(available) : 0, 1);
+    string.reserve(static_cast<typename _string_t::size_type>(std::min<std::size_t>(std::max<std::size_t>(wanted, 2 * string.capacity()), string.max_size())));
+    return true;
+}
+
+// Reads characters into the string until the delimiter, which is extracted but not stored, or the end of the stream.
+// The string is cleared first, but keeps its allocation, and characters are read straight into its spare capacity,
+// a buffer at a time. Like std::getline, sets failbit if nothing was extracted or the string reached its max size.
+template <typename _char_t, typename _istream_traits_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+std::basic_istream<_char_t, _istream_traits_t>& getline(
+    std::basic_istream<_char_t, _istream_traits_t>& istream,
+    basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string,
+    _char_t delimiter
+)
+{
+    string.clear();
+    std::streamsize extracted = 0;
+    while (true)
+    {
+        if (string.size() == string.capacity() && !_grow_for_extraction(string, istream))
+        {
+            istream.setstate(std::ios_base::failbit);
+            break;
+        }
+
+        // The stream's getline scans its buffer for the delimiter directly and null terminates,
+        // which the string has room for after its capacity.
+        std::size_t size = string.size();
+        std::size_t spare = string.capacity() - size;
+        string.resize_and_overwrite(string.capacity(), [&istream, delimiter, size, spare](_char_t* elements, auto)
+        {
+            istream.getline(elements + size, static_cast<std::streamsize>(spare) + 1, delimiter);
+            // Stopping at a found delimiter is the only way to leave the stream good. It's counted, but not stored.
+            std::size_t stored = static_cast<std::size_t>(istream.gcount());
+            if (istream.good())
+                --stored;
+            return size + stored;
+        });
+        extracted += istream.gcount();
+
+        // Filling the spare capacity without finding the delimiter sets failbit, so make room and carry on.
+        if ((istream.rdstate() & (std::ios_base::failbit | std::ios_base::eofbit)) == std::ios_base::failbit && istream.gcount() != 0)
+        {
+            istream.clear(istream.rdstate() & ~std::ios_base::failbit);
+            continue;
+        }
+        break;
+    }
+    if (extracted == 0)
+        istream.setstate(std::ios_base::failbit);
+    return istream;
+}
+
+// Reads characters into the string until the end of the line, or the end of the stream.
+template <typename _char_t, typename _istream_traits_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+std::basic_istream<_char_t, _istream_traits_t>& getline(
+    std::basic_istream<_char_t, _istream_traits_t>& istream,
+    basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string
+)
+{
+    return getline(istream, string, istream.widen('\n'));
+}
+
+// Reads a whitespace delimited word into the string, after skipping leading whitespace, honoring the stream's width.
+// The string is cleared first, but keeps its allocation, and characters are written straight into its spare capacity.
+// Like std::string's extraction, sets failbit if nothing was extracted.
+template <typename _char_t, typename _istream_traits_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+std::basic_istream<_char_t, _istream_traits_t>& operator>>(
+    std::basic_istream<_char_t, _istream_traits_t>& istream,
+    basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string
+)
+{
+    using int_type = typename _istream_traits_t::int_type;
+
+    string.clear();
+    typename std::basic_istream<_char_t, _istream_traits_t>::sentry sentry(istream);
+    if (!sentry)
+        return istream;
+
+    std::size_t limit = istream.width() > 0 ? static_cast<std::size_t>(istream.width()) : string.max_size();
+    const auto& ctype = std::use_facet<std::ctype<_char_t>>(istream.getloc());
+    auto* streambuf = istream.rdbuf();
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    int_type next = streambuf->sgetc();
+    while (string.size() < limit)
+    {
+        if (string.size() == string.capacity() && !_grow_for_extraction(string, istream))
+            break;
+
+        // Fill the spare capacity, then publish the new size once.
+        std::size_t size = string.size();
+        std::size_t end = std::min<std::size_t>(string.capacity(), limit);
+        bool done = false;
+        string.resize_and_overwrite(string.capacity(), [&](_char_t* elements, auto)
+        {
+            for (; size < end; ++size)
+            {
+                if (_istream_traits_t::eq_int_type(next, _istream_traits_t::eof()))
+                {
+                    state |= std::ios_base::eofbit;
+                    done = true;
+                    break;
+                }
+                _char_t element = _istream_traits_t::to_char_type(next);
+                if (ctype.is(std::ctype_base::space, element))
+                {
+                    done = true;
+                    break;
+                }
+                elements[size] = element;
+                next = streambuf->snextc();
+            }
+            return size;
+        });
+        if (done)
+            break;
+    }
+
+    istream.width(0);
+    if (string.empty())
+        state |= std::ios_base::failbit;
+    istream.setstate(state);
+    return istream;
+}
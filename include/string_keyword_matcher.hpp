@@ -0,0 +1,209 @@
+#pragma once
+
+#include "string_view.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+// Loads the code units at `data` that fit in 8 bytes as a little-endian word, zero-filled past `count` units.
+template <typename _char_t>
+constexpr std::uint64_t _load_units_word(const _char_t* data, std::size_t count) noexcept
+{
+    constexpr std::size_t units = 8 / sizeof(_char_t);
+    std::uint64_t word = 0;
+    // Copying only the units there are keeps the load within the view, where the compiler can see it.
+    if constexpr (sizeof(_char_t) == 1 && std::endian::native == std::endian::little)
+    {
+        if !consteval
+        {
+            std::memcpy(&word, data, std::min(count, units));
+            return word;
+        }
+    }
+    for (std::size_t i = 0; i < std::min(count, units); ++i)
+        word |= std::uint64_t(static_cast<std::make_unsigned_t<_char_t>>(data[i])) << (8 * sizeof(_char_t) * i);
+    return word;
+}
+
+// Matches strings against a fixed set of keywords, returning the index of the matching keyword.
+// It's built, usually at compile time, into a decision tree that first branches on the length,
+// then on whichever 8-byte word of the string best tells the remaining keywords apart, until one is left to compare.
+// Each branch is a binary search of at most as many values as there are keywords, so small sets beat any hash.
+template <std::size_t _count, typename _char_t = char, typename _size_t = std::size_t>
+class basic_keyword_matcher
+{
+public:
+    using key_type = basic_string_view<_char_t, _size_t>;
+    using size_type = std::size_t;
+
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    static_assert(_count != 0, "A keyword matcher must have at least one keyword.");
+
+public:
+    // Builds the decision tree. Duplicate keywords make building fail, at compile time if it's constant evaluated.
+    [[nodiscard]] explicit constexpr basic_keyword_matcher(const key_type (&keywords)[_count]) noexcept
+    {
+        std::uint32_t indices[_count]{};
+        for (size_type i = 0; i < _count; ++i)
+        {
+            _keywords[i] = keywords[i];
+            indices[i] = static_cast<std::uint32_t>(i);
+        }
+
+        // The root branches on the length.
+        _Node& root = _nodes[_node_count++];
+        root.word = _length_branch;
+        _branch(root, indices, _count, [this](std::uint32_t keyword) { return std::uint64_t(_keywords[keyword].size()); });
+    }
+
+public:
+    // Returns the index of the keyword equal to the view, or npos if there is none.
+    [[nodiscard]] constexpr size_type match(key_type view) const noexcept
+    {
+        const _Node* node = _nodes;
+        std::uint64_t value = view.size();
+        while (true)
+        {
+            std::int32_t child = _find_edge(*node, value);
+            if (child == _no_edge)
+                return npos;
+            if (child < 0)
+            {
+                size_type keyword = static_cast<size_type>(~child);
+                return _keywords[keyword] == view ? keyword : npos;
+            }
+            node = _nodes + child;
+            size_type offset = size_type(node->word) * _units_per_word;
+            value = _load_units_word(view.data() + offset, view.size() - offset);
+        }
+    }
+
+    // Returns the index of the keyword equal to the view, or npos if there is none.
+    [[nodiscard]] constexpr size_type operator()(key_type view) const noexcept { return match(view); }
+
+    // Returns the keyword at the given index.
+    [[nodiscard]] constexpr key_type operator[](size_type index) const noexcept { return _keywords[index]; }
+
+    // Returns the number of keywords.
+    [[nodiscard]] static constexpr size_type size() noexcept { return _count; }
+
+private:
+    static constexpr size_type _units_per_word = 8 / sizeof(_char_t);
+    static constexpr std::uint32_t _length_branch = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::int32_t _no_edge = std::numeric_limits<std::int32_t>::min();
+
+    // A branch on the length, or on one word of the string. Its edges are sorted by value.
+    struct _Node
+    {
+        std::uint32_t word = 0;
+        std::uint32_t first_edge = 0;
+        std::uint32_t edge_count = 0;
+    };
+
+    // An edge leads to a node, or if negative, to the complement of a keyword's index.
+    struct _Edge
+    {
+        std::uint64_t value = 0;
+        std::int32_t child = 0;
+    };
+
+    constexpr std::int32_t _find_edge(const _Node& node, std::uint64_t value) const noexcept
+    {
+        const _Edge* first = _edges + node.first_edge;
+        const _Edge* last = first + node.edge_count;
+        while (first != last)
+        {
+            const _Edge* middle = first + (last - first) / 2;
+            if (middle->value < value)
+                first = middle + 1;
+            else if (value < middle->value)
+                last = middle;
+            else
+                return middle->child;
+        }
+        return _no_edge;
+    }
+
+    // Gives the node an edge for each distinct value of the keywords, leading to a leaf if only one keyword has it.
+    template <typename _value_of_t>
+    constexpr void _branch(_Node& node, std::uint32_t* indices, size_type count, _value_of_t value_of) noexcept
+    {
+        // Sort the keywords by value, so equal values are adjacent and the edges come out sorted.
+        std::sort(indices, indices + count, [&value_of](std::uint32_t a, std::uint32_t b) { return value_of(a) < value_of(b); });
+        node.first_edge = _edge_count;
+        for (size_type i = 0; i < count; ++i)
+            if (i == 0 || value_of(indices[i - 1]) != value_of(indices[i]))
+                ++node.edge_count;
+        _edge_count += node.edge_count;
+
+        _Edge* edge = _edges + node.first_edge;
+        for (size_type begin = 0, end; begin < count; begin = end, ++edge)
+        {
+            for (end = begin + 1; end < count && value_of(indices[end]) == value_of(indices[begin]); ++end);
+            edge->value = value_of(indices[begin]);
+            edge->child = end - begin == 1 ? ~std::int32_t(indices[begin]) : _split(indices + begin, end - begin);
+        }
+    }
+
+    // Adds a node that tells keywords of the same length apart by the word with the most distinct values.
+    constexpr std::int32_t _split(std::uint32_t* indices, size_type count) noexcept
+    {
+        size_type length = _keywords[indices[0]].size();
+        auto word_of = [this](std::uint32_t keyword, size_type word)
+        {
+            size_type offset = word * _units_per_word;
+            return _load_units_word(_keywords[keyword].data() + offset, _keywords[keyword].size() - offset);
+        };
+
+        size_type best_word = 0;
+        size_type best_distinct = 1;
+        for (size_type word = 0; word * _units_per_word < length; ++word)
+        {
+            size_type distinct = 0;
+            for (size_type i = 0; i < count; ++i)
+            {
+                size_type j = 0;
+                while (j < i && word_of(indices[j], word) != word_of(indices[i], word))
+                    ++j;
+                distinct += j == i;
+            }
+            if (distinct > best_distinct)
+            {
+                best_word = word;
+                best_distinct = distinct;
+            }
+        }
+        if (best_distinct == 1)
+            std::abort(); // Duplicate keyword.
+
+        std::int32_t index = static_cast<std::int32_t>(_node_count++);
+        _Node& node = _nodes[index];
+        node.word = static_cast<std::uint32_t>(best_word);
+        _branch(node, indices, count, [&word_of, best_word](std::uint32_t keyword) { return word_of(keyword, best_word); });
+        return index;
+    }
+
+private:
+    key_type _keywords[_count]{};
+    // Every node but the root splits its keywords at least in two, so there are at most as many nodes as keywords,
+    // and every edge but the root's leads to a different node or keyword.
+    _Node _nodes[_count]{};
+    _Edge _edges[2 * _count]{};
+    std::uint32_t _node_count = 0;
+    std::uint32_t _edge_count = 0;
+};
+
+// Builds a keyword matcher, e.g. constexpr auto verbs = make_keyword_matcher({ "GET", "PUT", "DELETE" });
+template <typename _char_t = char, typename _size_t = std::size_t, std::size_t _count>
+[[nodiscard]] constexpr basic_keyword_matcher<_count, _char_t, _size_t> make_keyword_matcher(
+    const std::type_identity_t<basic_string_view<_char_t, _size_t>> (&keywords)[_count]
+) noexcept
+{
+    return basic_keyword_matcher<_count, _char_t, _size_t>(keywords);
+}
+
+template <std::size_t _count> using keyword_matcher = basic_keyword_matcher<_count, char>;
+template <std::size_t _count> using u8keyword_matcher = basic_keyword_matcher<_count, char8_t>;
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "string.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <istream>
+#include <memory>
+#include <unistd.h>
+
+// Reads lines from a file descriptor or an input stream in large blocks, handing out each line as a view.
+// Lines end at '\n', optionally preceded by '\r', which aren't part of the views. A final line ending doesn't start another line.
+// A view points into the current block, so it's only valid until the next line is read. Only a line that straddles
+// blocks is copied, into a string that is reused for every such line. A straddling line longer than that string's
+// max_size() is cut short at it, the rest of the line is skipped, and error() reports EOVERFLOW.
+template
+<
+    typename _char_t,
+    typename _size_t = std::size_t,
+    _size_t _min_internal_capacity = 15 / sizeof(_char_t),
+    typename _traits_t = std::char_traits<_char_t>,
+    typename _allocator_t = STRING_DEFAULT_ALLOCATOR,
+    string_layout _layout = string_layout::standard
+>
+class basic_line_reader
+{
+public:
+    using string_type = basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>;
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+    using istream_type = std::basic_istream<_char_t, std::char_traits<_char_t>>;
+    using size_type = _size_t;
+
+    static constexpr std::size_t default_block_size = 256 * 1024;
+
+public:
+    // Reads from a file descriptor, which is not closed by the reader.
+    [[nodiscard]] explicit basic_line_reader(int descriptor, std::size_t block_size = default_block_size) requires (sizeof(_char_t) == 1)
+        : _block_size(_clamp_block_size(block_size)), _block(new _char_t[_block_size]), _descriptor(descriptor) {}
+
+    // Reads from the stream's buffer directly.
+    [[nodiscard]] explicit basic_line_reader(istream_type& stream, std::size_t block_size = default_block_size)
+        : _block_size(_clamp_block_size(block_size)), _block(new _char_t[_block_size]), _streambuf(stream.rdbuf()) {}
+
+    basic_line_reader(const basic_line_reader&) = delete;
+    basic_line_reader& operator=(const basic_line_reader&) = delete;
+
+public:
+    // Reads the next line. Returns false, leaving the line unchanged, if there are no more.
+    bool next(string_view_type& line)
+    {
+        _straddling.clear();
+        _truncated = false;
+        while (true)
+        {
+            string_view_type rest(_block.get() + _begin, static_cast<size_type>(_end - _begin));
+            size_type newline = rest.find(_char_t('\n'));
+            if (newline != string_view_type::npos)
+            {
+                _begin += newline + 1;
+                if (_straddling.empty())
+                    line = _remove_carriage_return(rest.substr(0, newline));
+                else
+                {
+                    _append_straddling(rest.substr(0, newline));
+                    line = _truncated ? string_view_type(_straddling) : _remove_carriage_return(_straddling);
+                }
+                return true;
+            }
+
+            // The line continues past this block, so keep what's in it.
+            _append_straddling(rest);
+            _begin = 0;
+            _end = _fill();
+            if (_end == 0)
+            {
+                if (_straddling.empty())
+                    return false;
+                line = _truncated ? string_view_type(_straddling) : _remove_carriage_return(_straddling);
+                return true;
+            }
+        }
+    }
+
+    // Returns the errno value of the last failure to read from the file descriptor,
+    // EOVERFLOW if a line was cut short, or 0.
+    [[nodiscard]] int error() const noexcept { return _error; }
+
+private:
+    // Blocks are scanned through views, so they can't be longer than a view can describe.
+    static constexpr std::size_t _clamp_block_size(std::size_t block_size) noexcept
+    {
+        return std::min<std::size_t>(block_size, string_view_type::max_size());
+    }
+
+    static constexpr string_view_type _remove_carriage_return(string_view_type line) noexcept
+    {
+        return !line.empty() && line[line.size() - 1] == _char_t('\r') ? line.remove_suffix(1) : line;
+    }
+
+    // Appends part of a line that straddles blocks, dropping whatever doesn't fit in the string.
+    void _append_straddling(string_view_type part)
+    {
+        if (_truncated)
+            return;
+        std::size_t room = _straddling.max_size() - _straddling.size();
+        if (part.size() > room)
+        {
+            part = part.substr(0, static_cast<size_type>(room));
+            _truncated = true;
+            _error = EOVERFLOW;
+        }
+        _append_overwrite(_straddling, part.size(), [part](_char_t* elements) { _traits_t::copy(elements, part.data(), part.size()); });
+    }
+
+    // Reads the next block, returning its size, or 0 at the end.
+    std::size_t _fill()
+    {
+        if (_streambuf != nullptr)
+            return static_cast<std::size_t>(_streambuf->sgetn(_block.get(), static_cast<std::streamsize>(_block_size)));
+
+        while (true)
+        {
+            ssize_t count = ::read(_descriptor, _block.get(), _block_size);
+            if (count >= 0)
+                return static_cast<std::size_t>(count);
+            if (errno != EINTR)
+            {
+                _error = errno;
+                return 0;
+            }
+        }
+    }
+
+private:
+    std::size_t _block_size;
+    std::unique_ptr<_char_t[]> _block;
+    std::size_t _begin = 0;
+    std::size_t _end = 0;
+    string_type _straddling;
+    bool _truncated = false;
+    int _descriptor = -1;
+    std::basic_streambuf<_char_t, std::char_traits<_char_t>>* _streambuf = nullptr;
+    int _error = 0;
+};
+
+using line_reader = basic_line_reader<char>;
+using u8line_reader = basic_line_reader<char8_t>;
+using wline_reader = basic_line_reader<wchar_t>;
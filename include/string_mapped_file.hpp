@@ -0,0 +1,173 @@
+#pragma once
+
+// Read-only memory-mapped files, for POSIX systems.
+
+#include "string_split.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+// How a file will be read, passed on to the kernel when it's mapped.
+struct mapped_file_options
+{
+    // Read ahead aggressively and drop pages behind, for reading from start to end.
+    bool sequential = true;
+    // Start reading the whole file in right away.
+    bool will_need = true;
+    // Back the mapping with transparent huge pages, where the file system supports it.
+    bool huge_pages = false;
+};
+
+// Maps a whole file read-only, exposing its contents as views without copying them.
+// Failing to open or map the file leaves it closed, with error() returning the errno value.
+class mapped_file
+{
+public:
+    [[nodiscard]] mapped_file() noexcept = default;
+
+    [[nodiscard]] explicit mapped_file(const char* path, mapped_file_options options = {}) noexcept
+    {
+        open(path, options);
+    }
+
+    [[nodiscard]] mapped_file(mapped_file&& file) noexcept
+        : _data(std::exchange(file._data, nullptr)), _size(std::exchange(file._size, 0)),
+        _open(std::exchange(file._open, false)), _error(std::exchange(file._error, 0)) {}
+
+    mapped_file& operator=(mapped_file&& file) noexcept
+    {
+        if (this != &file)
+        {
+            close();
+            _data = std::exchange(file._data, nullptr);
+            _size = std::exchange(file._size, 0);
+            _open = std::exchange(file._open, false);
+            _error = std::exchange(file._error, 0);
+        }
+        return *this;
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file() noexcept { close(); }
+
+public:
+    // Maps the file at the given path, closing the current one first. Returns if it succeeded.
+    bool open(const char* path, mapped_file_options options = {}) noexcept
+    {
+        close();
+        int descriptor = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (descriptor == -1)
+            return _fail();
+
+        struct stat status;
+        if (::fstat(descriptor, &status) == -1)
+        {
+            int error = errno;
+            ::close(descriptor);
+            return _fail(error);
+        }
+
+        // Empty files can't be mapped, but are still open.
+        std::size_t size = static_cast<std::size_t>(status.st_size);
+        if (size != 0)
+        {
+            void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (data == MAP_FAILED)
+            {
+                int error = errno;
+                ::close(descriptor);
+                return _fail(error);
+            }
+            _data = static_cast<const char*>(data);
+            _size = size;
+            _advise(options);
+        }
+        // The mapping stays valid after the descriptor is closed.
+        ::close(descriptor);
+        _open = true;
+        return true;
+    }
+
+    // Unmaps the file, if one is mapped.
+    void close() noexcept
+    {
+        if (_data != nullptr)
+            ::munmap(const_cast<char*>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+        _open = false;
+        _error = 0;
+    }
+
+public:
+    // Returns if a file is mapped.
+    [[nodiscard]] bool is_open() const noexcept { return _open; }
+
+    // Returns if a file is mapped.
+    [[nodiscard]] explicit operator bool() const noexcept { return _open; }
+
+    // Returns the errno value of the last failure to open a file, or 0.
+    [[nodiscard]] int error() const noexcept { return _error; }
+
+    // Returns a pointer to the contents, or nullptr if there are none.
+    [[nodiscard]] const char* data() const noexcept { return _data; }
+
+    // Returns the size of the file in bytes.
+    [[nodiscard]] std::size_t size() const noexcept { return _size; }
+
+    // Returns if the file is empty.
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+    // Returns a view of the contents, e.g. view<char8_t>() for UTF-8 text.
+    // Returns an empty view if the file is larger than the view's max_size().
+    template <typename _char_t = char, typename _size_t = std::size_t, typename _traits_t = std::char_traits<_char_t>>
+        requires (sizeof(_char_t) == 1)
+    [[nodiscard]] basic_string_view<_char_t, _size_t, _traits_t> view() const noexcept
+    {
+        using view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+        if (_size > view_type::max_size())
+            return {};
+        return { reinterpret_cast<const _char_t*>(_data), static_cast<_size_t>(_size) };
+    }
+
+    // Returns a lazy range over the lines of the contents.
+    template <typename _char_t = char, typename _size_t = std::size_t, typename _traits_t = std::char_traits<_char_t>>
+        requires (sizeof(_char_t) == 1)
+    [[nodiscard]] basic_line_view<_char_t, _size_t, _traits_t> lines() const noexcept
+    {
+        return ::lines(view<_char_t, _size_t, _traits_t>());
+    }
+
+private:
+    void _advise(mapped_file_options options) noexcept
+    {
+        // These are only hints, so failures are ignored.
+        void* data = const_cast<char*>(_data);
+        if (options.sequential)
+            ::madvise(data, _size, MADV_SEQUENTIAL);
+        if (options.will_need)
+            ::madvise(data, _size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+        if (options.huge_pages)
+            ::madvise(data, _size, MADV_HUGEPAGE);
+#endif
+    }
+
+    bool _fail(int error = errno) noexcept
+    {
+        _error = error;
+        return false;
+    }
+
+private:
+    const char* _data = nullptr;
+    std::size_t _size = 0;
+    bool _open = false;
+    int _error = 0;
+};
+
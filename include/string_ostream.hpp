@@ -4,20 +4,34 @@
 #include <ostream>
 #include <string_view>
 
-template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t>
-std::basic_ostream<_char_t, _traits_t>& operator<<(
-    std::basic_ostream<_char_t, _traits_t>& ostream,
-    const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t>& str
+// Inserts the characters into the stream. Without padding, they are written straight to the stream buffer,
+// skipping the formatted output path, which only matters when a width is set.
+template <typename _char_t, typename _ostream_traits_t>
+std::basic_ostream<_char_t, _ostream_traits_t>& _insert(std::basic_ostream<_char_t, _ostream_traits_t>& ostream, const _char_t* data, std::size_t size)
+{
+    if (ostream.width() != 0)
+        return ostream << std::basic_string_view<_char_t, _ostream_traits_t>(data, size);
+
+    typename std::basic_ostream<_char_t, _ostream_traits_t>::sentry sentry(ostream);
+    if (sentry && ostream.rdbuf()->sputn(data, static_cast<std::streamsize>(size)) != static_cast<std::streamsize>(size))
+        ostream.setstate(std::ios_base::badbit);
+    return ostream;
+}
+
+template <typename _char_t, typename _ostream_traits_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+std::basic_ostream<_char_t, _ostream_traits_t>& operator<<(
+    std::basic_ostream<_char_t, _ostream_traits_t>& ostream,
+    const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& str
 )
 {
-    return ostream << std::basic_string_view<_char_t, _traits_t>(str.data(), str.size());
+    return _insert(ostream, str.data(), str.size());
 }
 
-template <typename _char_t, typename _size_t, typename _traits_t>
-std::basic_ostream<_char_t, _traits_t>& operator<<(
-    std::basic_ostream<_char_t, _traits_t>& ostream,
+template <typename _char_t, typename _ostream_traits_t, typename _size_t, typename _traits_t>
+std::basic_ostream<_char_t, _ostream_traits_t>& operator<<(
+    std::basic_ostream<_char_t, _ostream_traits_t>& ostream,
     basic_string_view<_char_t, _size_t, _traits_t> view
 )
 {
-    return ostream << std::basic_string_view<_char_t, _traits_t>(view.data(), view.size());
+    return _insert(ostream, view.data(), view.size());
 }
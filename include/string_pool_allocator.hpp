@@ -0,0 +1,372 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// The result of allocate_at_least, laid out like C++23's std::allocation_result, which g++ doesn't have yet.
+// basic_string takes any allocator with an allocate_at_least returning `ptr` and `count`, and uses all `count` elements.
+template <typename _pointer_t>
+struct sized_allocation
+{
+    _pointer_t ptr;
+    std::size_t count;
+};
+
+// The size classes of a pool, as a table, so a block size is found with one lookup.
+// Classes start at 16 bytes and are spaced by 8 bytes, or by a fraction of the power of two below them,
+// so `_classes_per_doubling` of 1 gives powers of two, and 4 gives classes about 1.25x apart.
+template <std::size_t _classes_per_doubling>
+struct _pool_size_classes
+{
+    static_assert(_classes_per_doubling == 1 || _classes_per_doubling == 2 || _classes_per_doubling == 4,
+        "A pool has 1, 2 or 4 size classes per doubling.");
+
+    static constexpr std::size_t min_size = 16;
+    static constexpr std::size_t max_size = 4096; // Larger allocations go straight to operator new.
+    static constexpr std::size_t granularity = 8; // Blocks hold pointers while free.
+
+    static constexpr std::size_t _next(std::size_t size) noexcept
+    {
+        return size + std::max(granularity, std::bit_floor(size) / _classes_per_doubling);
+    }
+
+    static consteval std::size_t _count() noexcept
+    {
+        std::size_t count = 0;
+        for (std::size_t size = min_size; size <= max_size; size = _next(size))
+            ++count;
+        return count;
+    }
+
+    static constexpr std::size_t count = _count();
+
+    // The block size of each class.
+    static constexpr std::array<std::uint32_t, count> sizes = []
+    {
+        std::array<std::uint32_t, count> sizes{};
+        std::size_t size = min_size;
+        for (std::uint32_t& entry : sizes)
+        {
+            entry = static_cast<std::uint32_t>(size);
+            size = _next(size);
+        }
+        return sizes;
+    }();
+
+    // The class of each size, rounded up to the granularity.
+    static constexpr std::array<std::uint8_t, max_size / granularity + 1> classes = []
+    {
+        std::array<std::uint8_t, max_size / granularity + 1> classes{};
+        std::uint8_t index = 0;
+        for (std::size_t i = 0; i < classes.size(); ++i)
+        {
+            while (sizes[index] < i * granularity)
+                ++index;
+            classes[i] = index;
+        }
+        return classes;
+    }();
+
+    // Returns the class of the given size, which must be at most max_size.
+    [[nodiscard]] static constexpr std::size_t of(std::size_t bytes) noexcept { return classes[(bytes + granularity - 1) / granularity]; }
+};
+
+// A free block. While free, its first bytes link it to the next block in the same list.
+struct _pool_block
+{
+    _pool_block* next;
+    _pool_block* next_batch; // Only in the first block of a batch on a central list.
+};
+
+// The head of a central list keeps a tag in the top 16 bits of its pointer, so pointers must fit in the low 48.
+// Heap pointers with tags in their top bits, from HWASan or memory tagging, don't.
+#if defined(__SANITIZE_HWADDRESS__) || defined(__ARM_FEATURE_MEMORY_TAGGING) || (defined(__aarch64__) && defined(__ANDROID__))
+#error "The string pool needs heap pointers without tags in their top 16 bits."
+#elif defined(__has_feature)
+#if __has_feature(hwaddress_sanitizer)
+#error "The string pool needs heap pointers without tags in their top 16 bits."
+#endif
+#endif
+
+// A lock-free stack of batches of free blocks, shared by every thread. The top 16 bits of the head are bumped
+// on every change, so a pop can't be fooled by its batch being popped and pushed back meanwhile.
+// A pop reads the next batch out of the batch it saw on top, which another thread may have popped and started
+// writing a string into meanwhile. That is a data race in the C++ memory model, and the value read is garbage,
+// but the compare-exchange then fails on the bumped tag and the value is dropped. It relies on blocks never being
+// returned to the system, so the read can't fault, and on the read being atomic, so it can't tear.
+class _pool_central_list
+{
+public:
+    void push(_pool_block* batch) noexcept
+    {
+        std::uint64_t head = _head.load(std::memory_order_relaxed);
+        do
+            std::atomic_ref(batch->next_batch).store(_pointer(head), std::memory_order_relaxed);
+        while (!_head.compare_exchange_weak(head, _pack(batch, head), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    [[nodiscard]] _pool_block* pop() noexcept
+    {
+        std::uint64_t head = _head.load(std::memory_order_acquire);
+        while (_pool_block* batch = _pointer(head))
+        {
+            _pool_block* next = std::atomic_ref(batch->next_batch).load(std::memory_order_relaxed);
+            if (_head.compare_exchange_weak(head, _pack(next, head), std::memory_order_acquire, std::memory_order_acquire))
+                return batch;
+        }
+        return nullptr;
+    }
+
+private:
+    static constexpr std::uint64_t _pointer_mask = (std::uint64_t(1) << 48) - 1;
+
+    static _pool_block* _pointer(std::uint64_t head) noexcept { return reinterpret_cast<_pool_block*>(head & _pointer_mask); }
+
+    static std::uint64_t _pack(_pool_block* batch, std::uint64_t old_head) noexcept
+    {
+        assert((reinterpret_cast<std::uint64_t>(batch) & ~_pointer_mask) == 0 && "Heap pointers must fit in 48 bits.");
+        return (reinterpret_cast<std::uint64_t>(batch) & _pointer_mask) | ((old_head & ~_pointer_mask) + (_pointer_mask + 1));
+    }
+
+private:
+    std::atomic<std::uint64_t> _head = 0;
+};
+
+// The pool of one spacing of size classes: a central list per class, and each thread's cache of free blocks.
+// A thread allocates from and frees to its cache without synchronizing, moving whole batches to and from
+// the central lists when its cache runs dry or overflows, and carving new batches out of fresh chunks.
+template <std::size_t _classes_per_doubling>
+class _string_pool
+{
+public:
+    using classes = _pool_size_classes<_classes_per_doubling>;
+
+    [[nodiscard]] static void* allocate(std::size_t size_class)
+    {
+        _thread_cache& cache = _cache;
+        if (cache.state != _thread_state::active) [[unlikely]]
+            return _allocate_slow(size_class);
+        _pool_block* block = cache.heads[size_class];
+        if (block == nullptr) [[unlikely]]
+        {
+            _refill(cache, size_class);
+            block = cache.heads[size_class];
+        }
+        cache.heads[size_class] = block->next;
+        --cache.counts[size_class];
+        return block;
+    }
+
+    static void deallocate(void* pointer, std::size_t size_class) noexcept
+    {
+        _thread_cache& cache = _cache;
+        _pool_block* block = static_cast<_pool_block*>(pointer);
+        if (cache.state != _thread_state::active) [[unlikely]]
+        {
+            _deallocate_slow(block, size_class);
+            return;
+        }
+        block->next = cache.heads[size_class];
+        cache.heads[size_class] = block;
+        // Keep one batch at hand for the next allocations, and return the one before it.
+        if (++cache.counts[size_class] == 2 * _batch_size(size_class)) [[unlikely]]
+            _flush_batch(cache, size_class);
+    }
+
+private:
+    enum class _thread_state : std::uint8_t
+    {
+        unregistered, // The thread hasn't used the pool yet, so its cache won't be flushed when it exits.
+        active,
+        retired,      // The thread is exiting, and its cache has been flushed. Blocks go straight to the central lists.
+    };
+
+    // Constant initialized, so reaching it doesn't need a guard.
+    struct _thread_cache
+    {
+        _pool_block* heads[classes::count];
+        std::uint32_t counts[classes::count];
+        _thread_state state;
+    };
+
+    // Flushes the thread's cache when the thread exits.
+    struct _thread_flusher
+    {
+        ~_thread_flusher() noexcept
+        {
+            for (std::size_t size_class = 0; size_class < classes::count; ++size_class)
+                while (_cache.heads[size_class] != nullptr)
+                    _flush_batch(_cache, size_class);
+            _cache.state = _thread_state::retired;
+        }
+    };
+
+    // About 8 KiB of blocks per batch, keeping the central lists from being touched often by small classes.
+    static constexpr std::uint32_t _batch_size(std::size_t size_class) noexcept
+    {
+        return std::clamp<std::uint32_t>(8192 / classes::sizes[size_class], 8, 64);
+    }
+
+    static constexpr std::uint32_t _batches_per_chunk = 4;
+
+    static void* _allocate_slow(std::size_t size_class)
+    {
+        _thread_cache& cache = _cache;
+        if (cache.state == _thread_state::unregistered)
+        {
+            _register(cache);
+            return allocate(size_class);
+        }
+        // Retired: take a batch, and give back all but one block.
+        _pool_block* batch = _central[size_class].pop();
+        if (batch == nullptr)
+            batch = _carve(size_class);
+        if (batch->next != nullptr)
+            _central[size_class].push(batch->next);
+        return batch;
+    }
+
+    static void _deallocate_slow(_pool_block* block, std::size_t size_class) noexcept
+    {
+        _thread_cache& cache = _cache;
+        if (cache.state == _thread_state::unregistered)
+        {
+            _register(cache);
+            deallocate(block, size_class);
+            return;
+        }
+        block->next = nullptr;
+        _central[size_class].push(block);
+    }
+
+    static void _register(_thread_cache& cache) noexcept
+    {
+        // Using the flusher registers its destructor to run when the thread exits.
+        [[maybe_unused]] _thread_flusher* volatile flusher = &_flusher;
+        cache.state = _thread_state::active;
+    }
+
+    // Fills the cache's empty list with a batch from the central list, or a new chunk.
+    static void _refill(_thread_cache& cache, std::size_t size_class)
+    {
+        _pool_block* batch = _central[size_class].pop();
+        if (batch == nullptr)
+            batch = _carve(size_class);
+        std::uint32_t count = 0;
+        for (_pool_block* block = batch; block != nullptr; block = block->next)
+            ++count;
+        cache.heads[size_class] = batch;
+        cache.counts[size_class] = count;
+    }
+
+    // Moves up to a batch of blocks from the front of the cache's list to the central list.
+    static void _flush_batch(_thread_cache& cache, std::size_t size_class) noexcept
+    {
+        _pool_block* batch = cache.heads[size_class];
+        _pool_block* last = batch;
+        std::uint32_t count = 1;
+        for (; count < _batch_size(size_class) && last->next != nullptr; ++count)
+            last = last->next;
+        cache.heads[size_class] = last->next;
+        cache.counts[size_class] -= count;
+        last->next = nullptr;
+        _central[size_class].push(batch);
+    }
+
+    // Allocates a chunk of blocks, pushes all but one batch of them to the central list, and returns that one.
+    static _pool_block* _carve(std::size_t size_class)
+    {
+        std::size_t block_size = classes::sizes[size_class];
+        std::uint32_t batch_size = _batch_size(size_class);
+        auto* chunk = static_cast<std::byte*>(::operator new(sizeof(_pool_block) + block_size * batch_size * _batches_per_chunk));
+        // Chunks are linked without tags, so leak checkers see the blocks as reachable.
+        auto* header = reinterpret_cast<_pool_block*>(chunk);
+        header->next = _chunks.load(std::memory_order_relaxed);
+        while (!_chunks.compare_exchange_weak(header->next, header, std::memory_order_relaxed));
+        chunk += sizeof(_pool_block);
+        _pool_block* batches[_batches_per_chunk];
+        for (std::uint32_t i = 0; i < _batches_per_chunk; ++i)
+        {
+            std::byte* first = chunk + std::size_t(i) * batch_size * block_size;
+            for (std::uint32_t j = 0; j < batch_size; ++j)
+            {
+                auto* block = reinterpret_cast<_pool_block*>(first + j * block_size);
+                block->next = j + 1 < batch_size ? reinterpret_cast<_pool_block*>(first + (j + 1) * block_size) : nullptr;
+            }
+            batches[i] = reinterpret_cast<_pool_block*>(first);
+        }
+        for (std::uint32_t i = 1; i < _batches_per_chunk; ++i)
+            _central[size_class].push(batches[i]);
+        return batches[0];
+    }
+
+private:
+    static inline _pool_central_list _central[classes::count]{};
+    static inline std::atomic<_pool_block*> _chunks = nullptr;
+    static inline thread_local constinit _thread_cache _cache{};
+    static inline thread_local _thread_flusher _flusher;
+};
+
+// A stateless allocator that pools blocks of up to 4 KiB by size class, for the heap buffers of strings.
+// Its allocate_at_least reports the whole block, so a string's capacity grows to fill its size class.
+// Blocks freed by one thread are reused by it first, and move between threads a batch at a time.
+// Memory the pool has taken is kept for reuse, and never returned to the system.
+template <typename _value_t, std::size_t _classes_per_doubling = 4>
+class basic_pool_allocator
+{
+public:
+    using value_type = _value_t;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    template <typename _other_t>
+    struct rebind { using other = basic_pool_allocator<_other_t, _classes_per_doubling>; };
+
+    static_assert(alignof(value_type) <= _pool_size_classes<_classes_per_doubling>::granularity, "Blocks are only aligned to 8 bytes.");
+
+public:
+    constexpr basic_pool_allocator() noexcept = default;
+
+    template <typename _other_t>
+    constexpr basic_pool_allocator(const basic_pool_allocator<_other_t, _classes_per_doubling>&) noexcept {}
+
+public:
+    // Allocates at least `count` elements, returning how many fit in the block.
+    [[nodiscard]] sized_allocation<value_type*> allocate_at_least(size_type count)
+    {
+        size_type bytes = count * sizeof(value_type);
+        if (bytes > _pool::classes::max_size)
+            return { static_cast<value_type*>(::operator new(bytes)), count };
+        size_type size_class = _pool::classes::of(bytes);
+        return { static_cast<value_type*>(_pool::allocate(size_class)), _pool::classes::sizes[size_class] / sizeof(value_type) };
+    }
+
+    [[nodiscard]] value_type* allocate(size_type count) { return allocate_at_least(count).ptr; }
+
+    // Frees elements, given any count from what was asked for to what allocate_at_least returned.
+    void deallocate(value_type* elements, size_type count) noexcept
+    {
+        size_type bytes = count * sizeof(value_type);
+        if (bytes > _pool::classes::max_size)
+            ::operator delete(elements, bytes);
+        else
+            _pool::deallocate(elements, _pool::classes::of(bytes));
+    }
+
+    template <typename _other_t>
+    [[nodiscard]] constexpr bool operator==(const basic_pool_allocator<_other_t, _classes_per_doubling>&) const noexcept { return true; }
+
+private:
+    using _pool = _string_pool<_classes_per_doubling>;
+};
+
+template <typename _value_t> using pool_allocator = basic_pool_allocator<_value_t>;
+template <typename _value_t> using pow2_pool_allocator = basic_pool_allocator<_value_t, 1>;
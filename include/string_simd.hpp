@@ -0,0 +1,373 @@
+#pragma once
+
+// Vectorized kernels shared by the string headers.
+// They are only used at runtime; constant evaluation always takes the scalar paths.
+// If you wish to disable every vectorized path, define
+// STRING_NO_SIMD before including any of the string headers.
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(STRING_NO_SIMD) && defined(__SSE2__)
+#define STRING_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#define STRING_SIMD_SSSE3 1
+#include <tmmintrin.h>
+#endif
+#endif
+
+// Loads 8 unaligned bytes as a native-endian word.
+inline std::uint64_t _load_word(const void* data) noexcept
+{
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+// Loads 8 one-byte code units as a little-endian word, which also works in constant evaluation.
+template <typename _unit_t> requires (sizeof(_unit_t) == 1)
+constexpr std::uint64_t _load_little_endian_word(const _unit_t* data) noexcept
+{
+    if !consteval
+    {
+        if constexpr (std::endian::native == std::endian::little)
+            return _load_word(data);
+    }
+    std::uint64_t word = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+        word |= std::uint64_t(static_cast<unsigned char>(data[i])) << (8 * i);
+    return word;
+}
+
+// Returns the number of leading bytes that are ASCII, i.e. less than 0x80.
+inline std::size_t _ascii_prefix_length(const void* data, std::size_t size) noexcept
+{
+    auto bytes = static_cast<const unsigned char*>(data);
+    std::size_t i = 0;
+#if STRING_SIMD_SSE2
+    for (; i + 16 <= size; i += 16)
+    {
+        // The sign bit of every byte is exactly the non-ASCII bit.
+        int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i)));
+        if (mask != 0)
+            return i + std::countr_zero(static_cast<unsigned>(mask));
+    }
+#endif
+    for (; i + 8 <= size; i += 8)
+    {
+        std::uint64_t high_bits = _load_word(bytes + i) & 0x8080808080808080ull;
+        if (high_bits != 0)
+        {
+            if constexpr (std::endian::native == std::endian::little)
+                return i + std::countr_zero(high_bits) / 8;
+            else
+                return i + std::countl_zero(high_bits) / 8;
+        }
+    }
+    for (; i < size; ++i)
+        if (bytes[i] >= 0x80)
+            return i;
+    return size;
+}
+
+// Returns the number of leading code units that are ASCII, i.e. less than 0x80.
+template <typename _unit_t> requires (sizeof(_unit_t) > 1)
+inline std::size_t _ascii_prefix_length(const _unit_t* data, std::size_t size) noexcept
+{
+    std::size_t i = 0;
+#if STRING_SIMD_SSE2
+    constexpr std::size_t lanes = 16 / sizeof(_unit_t);
+    const __m128i non_ascii = sizeof(_unit_t) == 2 ? _mm_set1_epi16(short(0xFF80)) : _mm_set1_epi32(int(0xFFFFFF80));
+    // Inlined into a caller scanning a short array, GCC warns that the load may reach past it,
+    // without seeing that the loop only loads whole vectors within `size`.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+    for (; i + lanes <= size; i += lanes)
+    {
+        __m128i units = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), non_ascii);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(units, _mm_setzero_si128())) != 0xFFFF)
+            break;
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+    while (i < size && static_cast<std::uint32_t>(data[i]) < 0x80)
+        ++i;
+    return i;
+}
+
+// Copies the leading ASCII run of `source` into `destination`,
+// widening or narrowing the code units, and returns its length.
+template <typename _to_t, typename _from_t>
+inline std::size_t _copy_ascii(const _from_t* source, std::size_t size, _to_t* destination) noexcept
+{
+    std::size_t i = 0;
+#if STRING_SIMD_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    auto load = [source](std::size_t j) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + j)); };
+    auto store = [destination](std::size_t j, __m128i units) { _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + j), units); };
+
+    if constexpr (sizeof(_from_t) == 1)
+    {
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i bytes = load(i);
+            if (_mm_movemask_epi8(bytes) != 0)
+                break;
+            if constexpr (sizeof(_to_t) == 1)
+                store(i, bytes);
+            else if constexpr (sizeof(_to_t) == 2)
+            {
+                store(i, _mm_unpacklo_epi8(bytes, zero));
+                store(i + 8, _mm_unpackhi_epi8(bytes, zero));
+            }
+            else
+            {
+                __m128i low = _mm_unpacklo_epi8(bytes, zero);
+                __m128i high = _mm_unpackhi_epi8(bytes, zero);
+                store(i, _mm_unpacklo_epi16(low, zero));
+                store(i + 4, _mm_unpackhi_epi16(low, zero));
+                store(i + 8, _mm_unpacklo_epi16(high, zero));
+                store(i + 12, _mm_unpackhi_epi16(high, zero));
+            }
+        }
+    }
+    else if constexpr (sizeof(_from_t) == 2 && sizeof(_to_t) == 1)
+    {
+        const __m128i non_ascii = _mm_set1_epi16(short(0xFF80));
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i low = load(i), high = load(i + 8);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_or_si128(low, high), non_ascii), zero)) != 0xFFFF)
+                break;
+            store(i, _mm_packus_epi16(low, high));
+        }
+    }
+    else if constexpr (sizeof(_from_t) == 4 && sizeof(_to_t) == 1)
+    {
+        const __m128i non_ascii = _mm_set1_epi32(int(0xFFFFFF80));
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i a = load(i), b = load(i + 4), c = load(i + 8), d = load(i + 12);
+            __m128i all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(all, non_ascii), zero)) != 0xFFFF)
+                break;
+            store(i, _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+        }
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        auto unit = static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<_from_t>>(source[i]));
+        if (unit >= 0x80)
+            break;
+        destination[i] = static_cast<_to_t>(unit);
+    }
+    return i;
+}
+
+#if STRING_SIMD_SSE2
+// Lane-wise operations on vectors of `_unit_size`-byte integers.
+template <std::size_t _unit_size>
+struct _sse2_lanes;
+
+template <>
+struct _sse2_lanes<1>
+{
+    static constexpr std::size_t count = 16;
+    static __m128i set(std::uint32_t value) noexcept { return _mm_set1_epi8(static_cast<char>(value)); }
+    static __m128i equal(__m128i a, __m128i b) noexcept { return _mm_cmpeq_epi8(a, b); }
+    static __m128i greater(__m128i a, __m128i b) noexcept { return _mm_cmpgt_epi8(a, b); }
+};
+
+template <>
+struct _sse2_lanes<2>
+{
+    static constexpr std::size_t count = 8;
+    static __m128i set(std::uint32_t value) noexcept { return _mm_set1_epi16(static_cast<short>(value)); }
+    static __m128i equal(__m128i a, __m128i b) noexcept { return _mm_cmpeq_epi16(a, b); }
+    static __m128i greater(__m128i a, __m128i b) noexcept { return _mm_cmpgt_epi16(a, b); }
+};
+
+template <>
+struct _sse2_lanes<4>
+{
+    static constexpr std::size_t count = 4;
+    static __m128i set(std::uint32_t value) noexcept { return _mm_set1_epi32(static_cast<int>(value)); }
+    static __m128i equal(__m128i a, __m128i b) noexcept { return _mm_cmpeq_epi32(a, b); }
+    static __m128i greater(__m128i a, __m128i b) noexcept { return _mm_cmpgt_epi32(a, b); }
+};
+
+// Returns a byte mask of the lanes whose comparison came out true.
+inline unsigned _sse2_mask(__m128i comparison) noexcept { return static_cast<unsigned>(_mm_movemask_epi8(comparison)); }
+
+// Returns a lane mask of the units that aren't ASCII. Only the unit's first byte is set.
+template <std::size_t _unit_size>
+inline __m128i _sse2_non_ascii(__m128i units) noexcept
+{
+    if constexpr (_unit_size == 1)
+        return units;
+    else
+    {
+        using lanes = _sse2_lanes<_unit_size>;
+        return _mm_andnot_si128(lanes::equal(_mm_and_si128(units, lanes::set(~0x7Fu)), _mm_setzero_si128()), lanes::set(0x80));
+    }
+}
+
+// Flips the case of the ASCII letters from `first` to `first + 25`.
+template <std::size_t _unit_size>
+inline __m128i _sse2_flip_ascii_case(__m128i units, std::uint32_t first) noexcept
+{
+    using lanes = _sse2_lanes<_unit_size>;
+    // Units above 0x7F compare as negative or as greater than any letter, so they are never flipped.
+    __m128i letters = _mm_and_si128(lanes::greater(units, lanes::set(first - 1)), lanes::greater(lanes::set(first + 26), units));
+    return _mm_xor_si128(units, _mm_and_si128(letters, lanes::set(0x20)));
+}
+#endif
+
+// Converts whole blocks of ASCII letters to lowercase (or uppercase) from `source` into `destination`,
+// which may be the same. Stops at the first block with a non-ASCII unit if `_stop_at_non_ascii`.
+// Returns the number of units converted, which the caller finishes converting.
+template <bool _upper, bool _stop_at_non_ascii, typename _unit_t>
+inline std::size_t _convert_ascii_case_blocks(const _unit_t* source, std::size_t size, _unit_t* destination) noexcept
+{
+    std::size_t i = 0;
+#if STRING_SIMD_SSE2
+    constexpr std::size_t lanes = _sse2_lanes<sizeof(_unit_t)>::count;
+    for (; i + lanes <= size; i += lanes)
+    {
+        __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        if (_stop_at_non_ascii && _sse2_mask(_sse2_non_ascii<sizeof(_unit_t)>(units)) != 0)
+            break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _sse2_flip_ascii_case<sizeof(_unit_t)>(units, _upper ? 'a' : 'A'));
+    }
+#endif
+    return i;
+}
+
+// Returns the number of leading units in whole blocks that are equal ignoring ASCII case.
+// Stops at the first block with a non-ASCII unit if `_stop_at_non_ascii`.
+template <bool _stop_at_non_ascii, typename _unit_t>
+inline std::size_t _ascii_iequal_blocks(const _unit_t* a, const _unit_t* b, std::size_t size) noexcept
+{
+    std::size_t i = 0;
+#if STRING_SIMD_SSE2
+    using lanes = _sse2_lanes<sizeof(_unit_t)>;
+    for (; i + lanes::count <= size; i += lanes::count)
+    {
+        __m128i a_units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i b_units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        if (_stop_at_non_ascii && _sse2_mask(_mm_or_si128(_sse2_non_ascii<sizeof(_unit_t)>(a_units), _sse2_non_ascii<sizeof(_unit_t)>(b_units))) != 0)
+            break;
+        __m128i a_lower = _sse2_flip_ascii_case<sizeof(_unit_t)>(a_units, 'A');
+        __m128i b_lower = _sse2_flip_ascii_case<sizeof(_unit_t)>(b_units, 'A');
+        if (_sse2_mask(lanes::equal(a_lower, b_lower)) != 0xFFFF)
+            break;
+    }
+#endif
+    return i;
+}
+
+// Returns the offset of the first unit that is `lower` ignoring ASCII case, or, if `_or_non_ascii`, that isn't ASCII.
+// Only whole blocks are searched, so the offset is `size` rounded down to a block otherwise.
+template <bool _or_non_ascii, typename _unit_t>
+inline std::size_t _ascii_ifind_blocks(const _unit_t* data, std::size_t size, std::uint32_t lower) noexcept
+{
+    std::size_t i = 0;
+#if STRING_SIMD_SSE2
+    using lanes = _sse2_lanes<sizeof(_unit_t)>;
+    const __m128i target = lanes::set(lower);
+    for (; i + lanes::count <= size; i += lanes::count)
+    {
+        __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i found = lanes::equal(_sse2_flip_ascii_case<sizeof(_unit_t)>(units, 'A'), target);
+        if (_or_non_ascii)
+            found = _mm_or_si128(found, _sse2_non_ascii<sizeof(_unit_t)>(units));
+        if (unsigned mask = _sse2_mask(found))
+            return i + std::countr_zero(mask) / sizeof(_unit_t);
+    }
+#endif
+    return i;
+}
+
+#if STRING_SIMD_SSE2
+// Holds the units of a set of at most 16, each broadcast to a vector.
+template <std::size_t _unit_size>
+struct _sse2_set
+{
+    __m128i targets[16];
+    std::size_t size;
+
+    template <typename _unit_t>
+    _sse2_set(const _unit_t* set, std::size_t set_size) noexcept
+        : size(set_size)
+    {
+        for (std::size_t j = 0; j < size; ++j)
+            targets[j] = _sse2_lanes<_unit_size>::set(static_cast<std::uint32_t>(set[j]));
+    }
+
+    // Returns a byte mask of the lanes whose units are (or, if not `_in_set`, aren't) in the set.
+    template <bool _in_set>
+    unsigned mask(const void* data) const noexcept
+    {
+        __m128i units = _mm_loadu_si128(static_cast<const __m128i*>(data));
+        __m128i found = _mm_setzero_si128();
+        for (std::size_t j = 0; j < size; ++j)
+            found = _mm_or_si128(found, _sse2_lanes<_unit_size>::equal(units, targets[j]));
+        return _in_set ? _sse2_mask(found) : _sse2_mask(found) ^ 0xFFFF;
+    }
+};
+#endif
+
+// Returns the offset of the first unit that is (or, if not `_in_set`, isn't) any of the `set_size` units of `set`,
+// of which there may be at most 16. Two blocks are searched at a time, so long runs are skipped 32 bytes at a time.
+// Only whole blocks are searched, so the offset is `size` rounded down to a block otherwise.
+template <bool _in_set, typename _unit_t>
+inline std::size_t _find_any_blocks(const _unit_t* data, std::size_t size, const _unit_t* set, std::size_t set_size) noexcept
+{
+    std::size_t i = 0;
+#if STRING_SIMD_SSE2
+    constexpr std::size_t lanes = _sse2_lanes<sizeof(_unit_t)>::count;
+    const _sse2_set<sizeof(_unit_t)> targets(set, set_size);
+    for (; i + 2 * lanes <= size; i += 2 * lanes)
+    {
+        unsigned mask = targets.template mask<_in_set>(data + i) | targets.template mask<_in_set>(data + i + lanes) << 16;
+        if (mask != 0)
+            return i + std::countr_zero(mask) / sizeof(_unit_t);
+    }
+    for (; i + lanes <= size; i += lanes)
+        if (unsigned mask = targets.template mask<_in_set>(data + i))
+            return i + std::countr_zero(mask) / sizeof(_unit_t);
+#endif
+    return i;
+}
+
+// Returns one past the offset of the last unit that is (or, if not `_in_set`, isn't) any of the `set_size` units of `set`,
+// of which there may be at most 16. Two blocks are searched at a time, from the end.
+// Only whole blocks are searched, so the offset is what's left of `size` before them otherwise.
+template <bool _in_set, typename _unit_t>
+inline std::size_t _rfind_any_blocks(const _unit_t* data, std::size_t size, const _unit_t* set, std::size_t set_size) noexcept
+{
+    std::size_t i = size;
+#if STRING_SIMD_SSE2
+    constexpr std::size_t lanes = _sse2_lanes<sizeof(_unit_t)>::count;
+    const _sse2_set<sizeof(_unit_t)> targets(set, set_size);
+    for (; i >= 2 * lanes; i -= 2 * lanes)
+    {
+        unsigned mask = targets.template mask<_in_set>(data + i - 2 * lanes) | targets.template mask<_in_set>(data + i - lanes) << 16;
+        if (mask != 0)
+            return i - 2 * lanes + (31 - std::countl_zero(mask)) / sizeof(_unit_t) + 1;
+    }
+    for (; i >= lanes; i -= lanes)
+        if (unsigned mask = targets.template mask<_in_set>(data + i - lanes))
+            return i - lanes + (31 - std::countl_zero(mask)) / sizeof(_unit_t) + 1;
+#endif
+    return i;
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "string.hpp"
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+// A lazy range over the lines of a view, each yielded as a view without its line ending.
+// Lines end at '\n', optionally preceded by '\r'. A final line ending doesn't start another line.
+template <typename _char_t, typename _size_t, typename _traits_t>
+class basic_line_view : public std::ranges::view_interface<basic_line_view<_char_t, _size_t, _traits_t>>
+{
+public:
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+    using size_type = _size_t;
+
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = string_view_type;
+        using difference_type = std::ptrdiff_t;
+
+    public:
+        [[nodiscard]] constexpr iterator() noexcept = default;
+
+        [[nodiscard]] constexpr string_view_type operator*() const noexcept { return _view.substr(_begin, _end - _begin); }
+
+        constexpr iterator& operator++() noexcept
+        {
+            _begin = _next;
+            _find_end();
+            return *this;
+        }
+
+        constexpr iterator operator++(int) noexcept
+        {
+            iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const iterator& other) const noexcept { return _begin == other._begin; }
+
+        // Returns the offset of the first character of the current line.
+        [[nodiscard]] constexpr size_type offset() const noexcept { return _begin; }
+
+    private:
+        friend class basic_line_view;
+
+        [[nodiscard]] constexpr iterator(string_view_type view, size_type begin) noexcept
+            : _view(view), _begin(begin)
+        {
+            _find_end();
+        }
+
+        constexpr void _find_end() noexcept
+        {
+            if (_begin == _view.size())
+                return;
+            size_type newline = _view.find(_char_t('\n'), _begin);
+            if (newline == string_view_type::npos)
+                _end = _next = _view.size();
+            else
+            {
+                _end = newline - (newline != _begin && _view[newline - 1] == _char_t('\r'));
+                _next = newline + 1;
+            }
+        }
+
+    private:
+        string_view_type _view;
+        size_type _begin = 0;
+        size_type _end = 0;
+        size_type _next = 0;
+    };
+
+public:
+    [[nodiscard]] constexpr basic_line_view() noexcept = default;
+
+    [[nodiscard]] explicit constexpr basic_line_view(string_view_type view) noexcept
+        : _view(view) {}
+
+    [[nodiscard]] constexpr iterator begin() const noexcept { return { _view, 0 }; }
+    [[nodiscard]] constexpr iterator end() const noexcept { return { _view, _view.size() }; }
+
+    // Returns the underlying view.
+    [[nodiscard]] constexpr string_view_type base() const noexcept { return _view; }
+
+private:
+    string_view_type _view;
+};
+
+// Returns a lazy range over the lines of the view.
+template <typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr basic_line_view<_char_t, _size_t, _traits_t> lines(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    return basic_line_view<_char_t, _size_t, _traits_t>(view);
+}
+
+// Returns a lazy range over the lines of the string.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+[[nodiscard]] constexpr basic_line_view<_char_t, _size_t, _traits_t> lines(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string) noexcept
+{
+    return basic_line_view<_char_t, _size_t, _traits_t>(string);
+}
+
+// Finds a single delimiting character.
+template <typename _char_t, typename _size_t, typename _traits_t>
+struct _split_element
+{
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+
+    _char_t element;
+
+    constexpr _size_t find(string_view_type view, _size_t offset) const noexcept { return view.find(element, offset); }
+    constexpr _size_t size() const noexcept { return 1; }
+};
+
+// Finds a delimiting view. An empty one never matches.
+template <typename _char_t, typename _size_t, typename _traits_t>
+struct _split_sequence
+{
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+
+    string_view_type sequence;
+
+    constexpr _size_t find(string_view_type view, _size_t offset) const noexcept
+    {
+        return sequence.empty() ? string_view_type::npos : view.find(sequence, offset);
+    }
+    constexpr _size_t size() const noexcept { return sequence.size(); }
+};
+
+// Finds any one of a set of delimiting characters.
+template <typename _char_t, typename _size_t, typename _traits_t>
+struct _split_set
+{
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+
+    string_view_type set;
+
+    constexpr _size_t find(string_view_type view, _size_t offset) const noexcept { return view.find_first_of(set, offset); }
+    constexpr _size_t size() const noexcept { return 1; }
+};
+
+// A lazy range over the pieces of a view between its delimiters, each yielded as a view.
+// Adjacent delimiters yield empty pieces, as does a delimiter at either end. An empty view has no pieces.
+template <typename _char_t, typename _size_t, typename _traits_t, typename _delimiter_t>
+class basic_split_view : public std::ranges::view_interface<basic_split_view<_char_t, _size_t, _traits_t, _delimiter_t>>
+{
+public:
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+    using size_type = _size_t;
+
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = string_view_type;
+        using difference_type = std::ptrdiff_t;
+
+    public:
+        [[nodiscard]] constexpr iterator() noexcept = default;
+
+        [[nodiscard]] constexpr string_view_type operator*() const noexcept { return _view.substr(_begin, _end - _begin); }
+
+        constexpr iterator& operator++() noexcept
+        {
+            _begin = _next;
+            _find_end();
+            return *this;
+        }
+
+        constexpr iterator operator++(int) noexcept
+        {
+            iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const iterator& other) const noexcept { return _begin == other._begin; }
+
+        // Returns the offset of the first character of the current piece.
+        [[nodiscard]] constexpr size_type offset() const noexcept { return _begin; }
+
+    private:
+        friend class basic_split_view;
+
+        // The end iterator begins one past the end of the view, so that a final delimiter still yields an empty piece.
+        [[nodiscard]] constexpr iterator(string_view_type view, _delimiter_t delimiter, size_type begin) noexcept
+            : _view(view), _delimiter(delimiter), _begin(begin)
+        {
+            _find_end();
+        }
+
+        constexpr void _find_end() noexcept
+        {
+            if (_begin > _view.size())
+                return;
+            size_type found = _delimiter.find(_view, _begin);
+            if (found == string_view_type::npos)
+            {
+                _end = _view.size();
+                _next = _view.size() + 1;
+            }
+            else
+            {
+                _end = found;
+                _next = found + _delimiter.size();
+            }
+        }
+
+    private:
+        string_view_type _view;
+        _delimiter_t _delimiter{};
+        size_type _begin = 0;
+        size_type _end = 0;
+        size_type _next = 0;
+    };
+
+public:
+    [[nodiscard]] constexpr basic_split_view() noexcept = default;
+
+    [[nodiscard]] constexpr basic_split_view(string_view_type view, _delimiter_t delimiter) noexcept
+        : _view(view), _delimiter(delimiter) {}
+
+    [[nodiscard]] constexpr iterator begin() const noexcept { return { _view, _delimiter, static_cast<size_type>(_view.empty()) }; }
+    [[nodiscard]] constexpr iterator end() const noexcept { return { _view, _delimiter, static_cast<size_type>(_view.size() + 1) }; }
+
+    // Returns the underlying view.
+    [[nodiscard]] constexpr string_view_type base() const noexcept { return _view; }
+
+private:
+    string_view_type _view;
+    _delimiter_t _delimiter{};
+};
+
+// Fills `pieces` with the pieces of the view between its delimiters, in one pass, returning how many there are.
+// If there are more pieces than room for them, the last one is the rest of the view, delimiters included.
+template <typename _char_t, typename _size_t, typename _traits_t, typename _delimiter_t>
+constexpr std::size_t _split_into(basic_string_view<_char_t, _size_t, _traits_t> view, _delimiter_t delimiter, std::span<basic_string_view<_char_t, _size_t, _traits_t>> pieces) noexcept
+{
+    if (view.empty() || pieces.empty())
+        return 0;
+    std::size_t count = 0;
+    _size_t begin = 0;
+    while (count + 1 < pieces.size())
+    {
+        _size_t found = delimiter.find(view, begin);
+        if (found == view.npos)
+            break;
+        pieces[count++] = view.substr(begin, found - begin);
+        begin = found + delimiter.size();
+    }
+    pieces[count++] = view.substr(begin);
+    return count;
+}
+
+// Returns a lazy range over the pieces of the view between occurrences of the delimiting character.
+template <typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr auto split(basic_string_view<_char_t, _size_t, _traits_t> view, std::type_identity_t<_char_t> delimiter) noexcept
+{
+    return basic_split_view<_char_t, _size_t, _traits_t, _split_element<_char_t, _size_t, _traits_t>>(view, { delimiter });
+}
+
+// Returns a lazy range over the pieces of the view between occurrences of the delimiting view.
+template <typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr auto split(basic_string_view<_char_t, _size_t, _traits_t> view, std::type_identity_t<basic_string_view<_char_t, _size_t, _traits_t>> delimiter) noexcept
+{
+    return basic_split_view<_char_t, _size_t, _traits_t, _split_sequence<_char_t, _size_t, _traits_t>>(view, { delimiter });
+}
+
+// Returns a lazy range over the pieces of the view between any of the characters in the set.
+template <typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr auto split_any(basic_string_view<_char_t, _size_t, _traits_t> view, std::type_identity_t<basic_string_view<_char_t, _size_t, _traits_t>> set) noexcept
+{
+    return basic_split_view<_char_t, _size_t, _traits_t, _split_set<_char_t, _size_t, _traits_t>>(view, { set });
+}
+
+// Returns a lazy range over the pieces of the string between occurrences of the delimiter.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout, typename _delimiter_t>
+[[nodiscard]] constexpr auto split(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string, const _delimiter_t& delimiter) noexcept
+    -> decltype(split(basic_string_view<_char_t, _size_t, _traits_t>(string), delimiter))
+{
+    return split(basic_string_view<_char_t, _size_t, _traits_t>(string), delimiter);
+}
+
+// Returns a lazy range over the pieces of the string between any of the characters in the set.
+template <typename _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+[[nodiscard]] constexpr auto split_any(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string, std::type_identity_t<basic_string_view<_char_t, _size_t, _traits_t>> set) noexcept
+{
+    return split_any(basic_string_view<_char_t, _size_t, _traits_t>(string), set);
+}
+
+// Fills `pieces` with the pieces of the view between occurrences of the delimiting character, returning how many there are.
+// If there are more pieces than room for them, the last one is the rest of the view, delimiters included.
+template <typename _char_t, typename _size_t, typename _traits_t>
+constexpr std::size_t split(basic_string_view<_char_t, _size_t, _traits_t> view, std::type_identity_t<_char_t> delimiter, std::span<std::type_identity_t<basic_string_view<_char_t, _size_t, _traits_t>>> pieces) noexcept
+{
+    return _split_into(view, _split_element<_char_t, _size_t, _traits_t>{ delimiter }, pieces);
+}
+
+// Fills `pieces` with the pieces of the view between occurrences of the delimiting view, returning how many there are.
+// If there are more pieces than room for them, the last one is the rest of the view, delimiters included.
+template <typename _char_t, typename _size_t, typename _traits_t>
+constexpr std::size_t split(basic_string_view<_char_t, _size_t, _traits_t> view, std::type_identity_t<basic_string_view<_char_t, _size_t, _traits_t>> delimiter, std::span<std::type_identity_t<basic_string_view<_char_t, _size_t, _traits_t>>> pieces) noexcept
+{
+    return _split_into(view, _split_sequence<_char_t, _size_t, _traits_t>{ delimiter }, pieces);
+}
+
+// Fills `pieces` with the pieces of the view between any of the characters in the set, returning how many there are.
+// If there are more pieces than room for them, the last one is the rest of the view, delimiters included.
+template <typename _char_t, typename _size_t, typename _traits_t>
+constexpr std::size_t split_any(basic_string_view<_char_t, _size_t, _traits_t> view, std::type_identity_t<basic_string_view<_char_t, _size_t, _traits_t>> set, std::span<std::type_identity_t<basic_string_view<_char_t, _size_t, _traits_t>>> pieces) noexcept
+{
+    return _split_into(view, _split_set<_char_t, _size_t, _traits_t>{ set }, pieces);
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "string_view.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+// Murmur3's finalizer.
+constexpr std::uint64_t _static_mix(std::uint64_t hash) noexcept
+{
+    hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCDull;
+    hash = (hash ^ (hash >> 33)) * 0xC4CEB9FE1A85EC53ull;
+    return hash ^ (hash >> 33);
+}
+
+// Hashes the code units of a view for the perfect hash of a static string map, the same at compile time as at runtime.
+template <typename _char_t, typename _size_t>
+constexpr std::uint64_t _static_hash(basic_string_view<_char_t, _size_t> view) noexcept
+{
+    auto mix = [](std::uint64_t hash, std::uint64_t value) { return std::rotl((hash ^ value) * 0x9E3779B97F4A7C15ull, 29); };
+    const _char_t* data = view.data();
+    std::size_t size = view.size();
+    std::uint64_t hash = size;
+    std::size_t i = 0;
+    if constexpr (sizeof(_char_t) == 1)
+        for (; i + 8 <= size; i += 8)
+            hash = mix(hash, _load_little_endian_word(data + i));
+    for (; i < size; ++i)
+        hash = mix(hash, static_cast<std::uint64_t>(data[i]));
+    return _static_mix(hash);
+}
+
+// An immutable map from strings to values, built once, usually at compile time, with a minimal perfect hash.
+// A lookup hashes the key once, probes one entry and compares one key. The keys must be unique,
+// and must outlive the map, which holds views of them; string literals do both.
+// The hash is "hash and displace": keys are grouped into buckets by their hash, and each bucket has a seed,
+// found when building, that moves its keys into free entries when mixed with their hash.
+template <typename _value_t, std::size_t _count, typename _char_t = char, typename _size_t = std::size_t>
+class basic_static_string_map
+{
+public:
+    using key_type = basic_string_view<_char_t, _size_t>;
+    using mapped_type = _value_t;
+    using value_type = std::pair<key_type, mapped_type>;
+    using size_type = std::size_t;
+    using const_iterator = const value_type*;
+
+    static_assert(_count != 0, "A static string map must have at least one key.");
+    static_assert(std::is_default_constructible_v<mapped_type>, "Values must be default constructible.");
+
+public:
+    // Builds the perfect hash. Duplicate keys make building fail, at compile time if it's constant evaluated.
+    [[nodiscard]] explicit constexpr basic_static_string_map(const value_type (&entries)[_count]) noexcept
+    {
+        for (size_type i = 0; i < _count; ++i)
+            for (size_type j = 0; j < i; ++j)
+                if (entries[i].first == entries[j].first)
+                    std::abort(); // Duplicate key.
+
+        std::uint64_t hashes[_count]{};
+        size_type bucket_sizes[_bucket_count]{};
+        for (size_type i = 0; i < _count; ++i)
+        {
+            hashes[i] = _static_hash(entries[i].first);
+            ++bucket_sizes[_bucket(hashes[i])];
+        }
+
+        // Place the largest buckets first, while there are the most free entries.
+        size_type order[_bucket_count]{};
+        for (size_type i = 0; i < _bucket_count; ++i)
+            order[i] = i;
+        std::sort(order, order + _bucket_count, [&bucket_sizes](size_type a, size_type b) { return bucket_sizes[a] > bucket_sizes[b]; });
+
+        bool taken[_count]{};
+        for (size_type bucket : order)
+        {
+            if (bucket_sizes[bucket] == 0)
+                break;
+            size_type members[_count]{};
+            size_type member_count = 0;
+            for (size_type i = 0; i < _count; ++i)
+                if (_bucket(hashes[i]) == bucket)
+                    members[member_count++] = i;
+
+            // Try seeds until every key in the bucket lands in a different free entry.
+            for (std::uint64_t seed = 0; ; ++seed)
+            {
+                size_type slots[_count]{};
+                size_type placed = 0;
+                for (; placed < member_count; ++placed)
+                {
+                    slots[placed] = _slot(hashes[members[placed]], seed);
+                    if (taken[slots[placed]] || std::find(slots, slots + placed, slots[placed]) != slots + placed)
+                        break;
+                }
+                if (placed == member_count)
+                {
+                    _seeds[bucket] = seed;
+                    for (size_type i = 0; i < member_count; ++i)
+                    {
+                        taken[slots[i]] = true;
+                        _entries[slots[i]] = entries[members[i]];
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+public:
+    // Returns a pointer to the value of the given key, or nullptr if there is none.
+    [[nodiscard]] constexpr const mapped_type* find(key_type key) const noexcept
+    {
+        std::uint64_t hash = _static_hash(key);
+        const value_type& entry = _entries[_slot(hash, _seeds[_bucket(hash)])];
+        return entry.first == key ? std::addressof(entry.second) : nullptr;
+    }
+
+    // Returns the value of the given key, or `fallback` if there is none.
+    [[nodiscard]] constexpr mapped_type value_or(key_type key, mapped_type fallback) const noexcept
+    {
+        const mapped_type* value = find(key);
+        return value != nullptr ? *value : fallback;
+    }
+
+    // Returns if the map contains the given key.
+    [[nodiscard]] constexpr bool contains(key_type key) const noexcept { return find(key) != nullptr; }
+
+    // Returns the number of keys.
+    [[nodiscard]] static constexpr size_type size() noexcept { return _count; }
+
+    // The entries are in the order of the hash, not the order they were given in.
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return _entries; }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return _entries + _count; }
+
+private:
+    // About two keys per bucket keeps the seeds small, and finding them quick.
+    static constexpr size_type _bucket_count = (_count + 1) / 2;
+
+    static constexpr size_type _bucket(std::uint64_t hash) noexcept { return static_cast<size_type>((hash >> 32) % _bucket_count); }
+
+    static constexpr size_type _slot(std::uint64_t hash, std::uint64_t seed) noexcept { return static_cast<size_type>(_static_mix(hash ^ seed) % _count); }
+
+private:
+    value_type _entries[_count]{};
+    std::uint64_t _seeds[_bucket_count]{};
+};
+
+// Builds a static string map from pairs of keys and values, e.g.
+// constexpr auto methods = make_static_string_map<method>({ { "GET", method::get }, { "POST", method::post } });
+template <typename _value_t, typename _char_t = char, typename _size_t = std::size_t, std::size_t _count>
+[[nodiscard]] constexpr basic_static_string_map<_value_t, _count, _char_t, _size_t> make_static_string_map(
+    const std::pair<basic_string_view<_char_t, _size_t>, _value_t> (&entries)[_count]
+) noexcept
+{
+    return basic_static_string_map<_value_t, _count, _char_t, _size_t>(entries);
+}
+
+template <typename _value_t, std::size_t _count> using static_string_map = basic_static_string_map<_value_t, _count, char>;
+template <typename _value_t, std::size_t _count> using static_u8string_map = basic_static_string_map<_value_t, _count, char8_t>;
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "string.hpp"
+#include "string_simd.hpp"
+#include <bit>
+#include <string>
+
+// Character traits that compare, find and hash characters ignoring ASCII case.
+// Only 'A'-'Z' and 'a'-'z' are considered the same, so this is suitable for protocol
+// keywords, header names and identifiers, but not for natural language text.
+template <typename _char_t>
+struct ascii_ci_char_traits : std::char_traits<_char_t>
+{
+    using char_type = _char_t;
+    using int_type = typename std::char_traits<_char_t>::int_type;
+
+    // Returns if the characters are equal ignoring ASCII case.
+    [[nodiscard]] static constexpr bool eq(char_type a, char_type b) noexcept { return _fold(a) == _fold(b); }
+
+    // Returns if the first character orders before the second ignoring ASCII case.
+    [[nodiscard]] static constexpr bool lt(char_type a, char_type b) noexcept { return _fold(a) < _fold(b); }
+
+    // Compares `count` characters ignoring ASCII case.
+    [[nodiscard]] static constexpr int compare(const char_type* a, const char_type* b, std::size_t count) noexcept
+    {
+        std::size_t i = 0;
+        if !consteval
+        {
+            i = _ascii_iequal_blocks<false>(a, b, count);
+        }
+        for (; i < count; ++i)
+            if (_fold(a[i]) != _fold(b[i]))
+                return _fold(a[i]) < _fold(b[i]) ? -1 : 1;
+        return 0;
+    }
+
+    // Returns a pointer to the first of `count` characters equal to `element` ignoring ASCII case, or nullptr if there is none.
+    [[nodiscard]] static constexpr const char_type* find(const char_type* data, std::size_t count, const char_type& element) noexcept
+    {
+        std::uint32_t lower = _fold(element);
+        std::size_t i = 0;
+        if !consteval
+        {
+            i = _ascii_ifind_blocks<false>(data, count, lower);
+        }
+        for (; i < count; ++i)
+            if (_fold(data[i]) == lower)
+                return data + i;
+        return nullptr;
+    }
+
+    // Hashes `count` characters ignoring ASCII case.
+    [[nodiscard]] static std::size_t hash(const char_type* data, std::size_t count) noexcept
+    {
+        std::uint64_t hash = 0x9E3779B97F4A7C15ull ^ count;
+        std::size_t i = 0;
+        if constexpr (sizeof(char_type) == 1)
+            for (; i + 8 <= count; i += 8)
+                hash = _mix(hash, _fold_word(_load_word(data + i)));
+        for (; i < count; ++i)
+            hash = _mix(hash, _fold(data[i]));
+
+        // Murmur3's finalizer.
+        hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCDull;
+        hash = (hash ^ (hash >> 33)) * 0xC4CEB9FE1A85EC53ull;
+        return static_cast<std::size_t>(hash ^ (hash >> 33));
+    }
+
+private:
+    // Returns the character as an unsigned value, lowercased if it's an ASCII letter.
+    static constexpr std::uint32_t _fold(char_type element) noexcept
+    {
+        auto unit = static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<char_type>>(element));
+        return 'A' <= unit && unit <= 'Z' ? unit + 0x20 : unit;
+    }
+
+    // Lowercases the ASCII letters in 8 bytes at once.
+    static constexpr std::uint64_t _fold_word(std::uint64_t word) noexcept
+    {
+        constexpr std::uint64_t ones = 0x0101010101010101ull;
+        // With the high bits cleared, adding can't carry between bytes.
+        std::uint64_t low_bits = word & (0x7F * ones);
+        std::uint64_t at_least_a = low_bits + (0x80 - 'A') * ones;
+        std::uint64_t above_z = low_bits + (0x80 - 'Z' - 1) * ones;
+        std::uint64_t upper = at_least_a & ~above_z & ~word & (0x80 * ones);
+        return word | (upper >> 2);
+    }
+
+    static constexpr std::uint64_t _mix(std::uint64_t hash, std::uint64_t value) noexcept
+    {
+        return std::rotl((hash ^ value) * 0x9E3779B97F4A7C15ull, 29);
+    }
+};
+
+using ci_string = basic_string<char, std::size_t, 15, ascii_ci_char_traits<char>>;
+using small_ci_string = basic_string<char, std::uint8_t, 15, ascii_ci_char_traits<char>>;
+using compact_ci_string = basic_string<char, std::uint32_t, 15, ascii_ci_char_traits<char>>;
+using ci_u8string = basic_string<char8_t, std::size_t, 15, ascii_ci_char_traits<char8_t>>;
+using small_ci_u8string = basic_string<char8_t, std::uint8_t, 15, ascii_ci_char_traits<char8_t>>;
+using compact_ci_u8string = basic_string<char8_t, std::uint32_t, 15, ascii_ci_char_traits<char8_t>>;
+
+using ci_string_view = basic_string_view<char, std::size_t, ascii_ci_char_traits<char>>;
+using small_ci_string_view = basic_string_view<char, std::uint8_t, ascii_ci_char_traits<char>>;
+using compact_ci_string_view = basic_string_view<char, std::uint32_t, ascii_ci_char_traits<char>>;
+using ci_u8string_view = basic_string_view<char8_t, std::size_t, ascii_ci_char_traits<char8_t>>;
+using small_ci_u8string_view = basic_string_view<char8_t, std::uint8_t, ascii_ci_char_traits<char8_t>>;
+using compact_ci_u8string_view = basic_string_view<char8_t, std::uint32_t, ascii_ci_char_traits<char8_t>>;
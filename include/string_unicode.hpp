@@ -0,0 +1,900 @@
+#pragma once
+
+#include "string.hpp"
+#include "string_simd.hpp"
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+
+// Character types whose strings hold UTF-8 code units.
+template <typename _char_t>
+concept _utf8_char = std::same_as<_char_t, char> || std::same_as<_char_t, char8_t>;
+
+// Returned by the internal validators when the input is well-formed.
+inline constexpr std::size_t _utf8_valid = std::numeric_limits<std::size_t>::max();
+
+// Character types whose strings hold Unicode code units.
+template <typename _char_t>
+concept _unicode_char = _utf8_char<_char_t> || std::same_as<_char_t, char16_t> || std::same_as<_char_t, char32_t>;
+
+// Substituted for every ill-formed sequence when transcoding.
+inline constexpr char32_t replacement_character = U'\uFFFD';
+
+// A code point decoded from the start of a sequence.
+struct _decoded_code_point
+{
+    // The replacement character if the sequence is ill-formed.
+    char32_t code_point;
+    // If ill-formed, the length of the maximal subpart to replace.
+    std::size_t length;
+    bool valid;
+    // If ill-formed, whether that is only because the input ended mid-sequence.
+    bool truncated;
+};
+
+// Returns the numeric value of a code unit.
+template <typename _char_t>
+constexpr std::uint32_t _code_unit(_char_t unit) noexcept
+{
+    return static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<_char_t>>(unit));
+}
+
+// Decodes the UTF-8 sequence starting at `data[i]`.
+template <typename _char_t>
+constexpr _decoded_code_point _utf8_decode(const _char_t* data, std::size_t size, std::size_t i) noexcept
+{
+    std::uint32_t lead = _code_unit(data[i]);
+    if (lead < 0x80)
+        return { lead, 1, true, false };
+
+    // Well-formed byte sequences, as per table 3-7 of the Unicode standard.
+    std::size_t length;
+    std::uint32_t low = 0x80, high = 0xBF;
+    char32_t code_point;
+    if (lead < 0xC2)
+        return { replacement_character, 1, false, false };
+    else if (lead < 0xE0)
+    {
+        length = 2;
+        code_point = lead & 0x1F;
+    }
+    else if (lead < 0xF0)
+    {
+        length = 3;
+        code_point = lead & 0x0F;
+        if (lead == 0xE0)
+            low = 0xA0; // Overlong.
+        else if (lead == 0xED)
+            high = 0x9F; // Surrogate.
+    }
+    else if (lead < 0xF5)
+    {
+        length = 4;
+        code_point = lead & 0x07;
+        if (lead == 0xF0)
+            low = 0x90; // Overlong.
+        else if (lead == 0xF4)
+            high = 0x8F; // Above U+10FFFF.
+    }
+    else
+        return { replacement_character, 1, false, false };
+
+    for (std::size_t j = 1; j < length; ++j)
+    {
+        if (i + j == size)
+            return { replacement_character, j, false, true };
+        std::uint32_t continuation = _code_unit(data[i + j]);
+        if (continuation < low || high < continuation)
+            return { replacement_character, j, false, false };
+        code_point = (code_point << 6) | (continuation & 0x3F);
+        low = 0x80;
+        high = 0xBF;
+    }
+    return { code_point, length, true, false };
+}
+
+// Decodes the UTF-16 sequence starting at `data[i]`.
+constexpr _decoded_code_point _utf16_decode(const char16_t* data, std::size_t size, std::size_t i) noexcept
+{
+    char32_t unit = data[i];
+    if (unit < 0xD800 || 0xDFFF < unit)
+        return { unit, 1, true, false };
+    if (unit <= 0xDBFF)
+    {
+        if (i + 1 == size)
+            return { replacement_character, 1, false, true };
+        char32_t trail = data[i + 1];
+        if (0xDC00 <= trail && trail <= 0xDFFF)
+            return { 0x10000 + ((unit - 0xD800) << 10) + (trail - 0xDC00), 2, true, false };
+    }
+    return { replacement_character, 1, false, false };
+}
+
+// Decodes the UTF-32 code unit at `data[i]`.
+constexpr _decoded_code_point _utf32_decode(const char32_t* data, std::size_t, std::size_t i) noexcept
+{
+    char32_t unit = data[i];
+    if (unit < 0xD800 || (0xDFFF < unit && unit <= 0x10FFFF))
+        return { unit, 1, true, false };
+    return { replacement_character, 1, false, false };
+}
+
+// Decodes the sequence starting at `data[i]` in the encoding of the character type.
+template <_unicode_char _char_t>
+constexpr _decoded_code_point _decode(const _char_t* data, std::size_t size, std::size_t i) noexcept
+{
+    if constexpr (sizeof(_char_t) == 1)
+        return _utf8_decode(data, size, i);
+    else if constexpr (sizeof(_char_t) == 2)
+        return _utf16_decode(data, size, i);
+    else
+        return _utf32_decode(data, size, i);
+}
+
+// Returns the number of code units needed to encode the code point in the encoding of the character type.
+template <_unicode_char _char_t>
+constexpr std::size_t _encoded_length(char32_t code_point) noexcept
+{
+    if constexpr (sizeof(_char_t) == 1)
+        return code_point < 0x80 ? 1 : code_point < 0x800 ? 2 : code_point < 0x10000 ? 3 : 4;
+    else if constexpr (sizeof(_char_t) == 2)
+        return code_point < 0x10000 ? 1 : 2;
+    else
+        return 1;
+}
+
+// Encodes a valid code point, returning the number of code units written.
+template <_unicode_char _char_t>
+constexpr std::size_t _encode(char32_t code_point, _char_t* destination) noexcept
+{
+    if constexpr (sizeof(_char_t) == 1)
+    {
+        if (code_point < 0x80)
+        {
+            destination[0] = static_cast<_char_t>(code_point);
+            return 1;
+        }
+        if (code_point < 0x800)
+        {
+            destination[0] = static_cast<_char_t>(0xC0 | (code_point >> 6));
+            destination[1] = static_cast<_char_t>(0x80 | (code_point & 0x3F));
+            return 2;
+        }
+        if (code_point < 0x10000)
+        {
+            destination[0] = static_cast<_char_t>(0xE0 | (code_point >> 12));
+            destination[1] = static_cast<_char_t>(0x80 | ((code_point >> 6) & 0x3F));
+            destination[2] = static_cast<_char_t>(0x80 | (code_point & 0x3F));
+            return 3;
+        }
+        destination[0] = static_cast<_char_t>(0xF0 | (code_point >> 18));
+        destination[1] = static_cast<_char_t>(0x80 | ((code_point >> 12) & 0x3F));
+        destination[2] = static_cast<_char_t>(0x80 | ((code_point >> 6) & 0x3F));
+        destination[3] = static_cast<_char_t>(0x80 | (code_point & 0x3F));
+        return 4;
+    }
+    else if constexpr (sizeof(_char_t) == 2)
+    {
+        if (code_point < 0x10000)
+        {
+            destination[0] = static_cast<_char_t>(code_point);
+            return 1;
+        }
+        code_point -= 0x10000;
+        destination[0] = static_cast<_char_t>(0xD800 | (code_point >> 10));
+        destination[1] = static_cast<_char_t>(0xDC00 | (code_point & 0x3FF));
+        return 2;
+    }
+    else
+    {
+        destination[0] = code_point;
+        return 1;
+    }
+}
+
+// Returns the length of the well-formed UTF-8 sequence starting at `data[i]`, or 0 if it is ill-formed.
+template <typename _char_t>
+constexpr std::size_t _utf8_sequence_length(const _char_t* data, std::size_t size, std::size_t i) noexcept
+{
+    auto decoded = _utf8_decode(data, size, i);
+    return decoded.valid ? decoded.length : 0;
+}
+
+// Validates from `i` onward one sequence at a time.
+template <typename _char_t>
+constexpr std::size_t _validate_utf8_scalar(const _char_t* data, std::size_t size, std::size_t i) noexcept
+{
+    while (i < size)
+    {
+        std::size_t length = _utf8_sequence_length(data, size, i);
+        if (length == 0)
+            return i;
+        i += length;
+    }
+    return _utf8_valid;
+}
+
+// Moves `i` back onto the lead byte of a sequence that may straddle it.
+inline std::size_t _utf8_resync(const unsigned char* data, std::size_t i) noexcept
+{
+    for (std::size_t back = 1; back <= 3 && back <= i; ++back)
+    {
+        if (data[i - back] >= 0xC0)
+            return i - back;
+        if (data[i - back] < 0x80)
+            break;
+    }
+    return i;
+}
+
+#if STRING_SIMD_SSSE3
+// Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte".
+// Every pair of adjacent bytes is classified with three nibble lookups, and
+// the third and fourth bytes of longer sequences are checked separately.
+// Returns a lead byte position before which the input is known to be well-formed.
+inline std::size_t _validate_utf8_ssse3(const unsigned char* data, std::size_t size) noexcept
+{
+    constexpr char too_short = 1 << 0;      // 11______ 0_______, 11______ 11______
+    constexpr char too_long = 1 << 1;       // 0_______ 10______
+    constexpr char overlong_3 = 1 << 2;     // 11100000 100_____
+    constexpr char too_large = 1 << 3;      // 11110100 1001____ and above
+    constexpr char surrogate = 1 << 4;      // 11101101 101_____
+    constexpr char overlong_2 = 1 << 5;     // 1100000_ 10______
+    constexpr char too_large_1000 = 1 << 6; // 11110101 1000____ and above
+    constexpr char overlong_4 = 1 << 6;     // 11110000 1000____
+    constexpr char two_continuations = char(1 << 7); // 10______ 10______
+    constexpr char carry = too_short | too_long | two_continuations;
+
+    const __m128i byte_1_high_table = _mm_setr_epi8(
+        too_long, too_long, too_long, too_long,
+        too_long, too_long, too_long, too_long,
+        two_continuations, two_continuations, two_continuations, two_continuations,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4
+    );
+    const __m128i byte_1_low_table = _mm_setr_epi8(
+        carry | overlong_3 | overlong_2 | overlong_4,
+        carry | overlong_2,
+        carry,
+        carry,
+        carry | too_large,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000 | surrogate,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000
+    );
+    const __m128i byte_2_high_table = _mm_setr_epi8(
+        too_short, too_short, too_short, too_short,
+        too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_continuations | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_continuations | overlong_3 | too_large,
+        too_long | overlong_2 | two_continuations | surrogate | too_large,
+        too_long | overlong_2 | two_continuations | surrogate | too_large,
+        too_short, too_short, too_short, too_short
+    );
+    // Any of the last three bytes exceeding these starts a sequence that continues into the next block.
+    const __m128i incomplete_limits = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1)
+    );
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+
+    auto any = [zero](__m128i bits) { return _mm_movemask_epi8(_mm_cmpeq_epi8(bits, zero)) != 0xFFFF; };
+
+    __m128i previous = zero;
+    __m128i previous_incomplete = zero;
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(input) == 0)
+        {
+            // An ASCII block can only be wrong by cutting off the previous block's last sequence.
+            if (any(previous_incomplete))
+                break;
+        }
+        else
+        {
+            __m128i previous_1 = _mm_alignr_epi8(input, previous, 15);
+            __m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(previous_1, 4), nibble_mask));
+            __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(previous_1, nibble_mask));
+            __m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask));
+            __m128i special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+            __m128i previous_2 = _mm_alignr_epi8(input, previous, 14);
+            __m128i previous_3 = _mm_alignr_epi8(input, previous, 13);
+            __m128i is_third_byte = _mm_subs_epu8(previous_2, _mm_set1_epi8(char(0xE0 - 0x80)));
+            __m128i is_fourth_byte = _mm_subs_epu8(previous_3, _mm_set1_epi8(char(0xF0 - 0x80)));
+            __m128i must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(char(0x80)));
+
+            if (any(_mm_xor_si128(must_be_continuation, special_cases)))
+                break;
+        }
+        previous_incomplete = _mm_subs_epu8(input, incomplete_limits);
+        previous = input;
+    }
+    return _utf8_resync(data, i);
+}
+#endif
+
+// Validates at runtime, skipping ASCII runs and well-formed blocks in bulk.
+inline std::size_t _validate_utf8_runtime(const unsigned char* data, std::size_t size) noexcept
+{
+    std::size_t i = 0;
+#if STRING_SIMD_SSSE3
+    i = _validate_utf8_ssse3(data, size);
+#endif
+    // Either the tail, or the block the error was found in.
+    while (i < size)
+    {
+        i += _ascii_prefix_length(data + i, size - i);
+        while (i < size && data[i] >= 0x80)
+        {
+            std::size_t length = _utf8_sequence_length(data, size, i);
+            if (length == 0)
+                return i;
+            i += length;
+        }
+    }
+    return _utf8_valid;
+}
+
+// Returns the offset of the first ill-formed UTF-8 sequence in
+// the view, or npos if the whole view is well-formed UTF-8.
+template <_utf8_char _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr _size_t validate_utf8(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    std::size_t offset;
+    if consteval
+    {
+        offset = _validate_utf8_scalar(view.data(), view.size(), 0);
+    }
+    else
+    {
+        offset = _validate_utf8_runtime(reinterpret_cast<const unsigned char*>(view.data()), view.size());
+    }
+    return offset == _utf8_valid ? view.npos : static_cast<_size_t>(offset);
+}
+
+// Returns the offset of the first ill-formed UTF-8 sequence in
+// the string, or npos if the whole string is well-formed UTF-8.
+template <_utf8_char _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+[[nodiscard]] constexpr _size_t validate_utf8(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string) noexcept
+{
+    return validate_utf8(basic_string_view<_char_t, _size_t, _traits_t>(string));
+}
+
+// Returns if the view is well-formed UTF-8.
+template <_utf8_char _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr bool is_valid_utf8(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    return validate_utf8(view) == view.npos;
+}
+
+// Returns if the string is well-formed UTF-8.
+template <_utf8_char _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+[[nodiscard]] constexpr bool is_valid_utf8(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string) noexcept
+{
+    return validate_utf8(string) == string.npos;
+}
+
+// Counts of the code points in well-formed UTF-8.
+struct _utf8_counts
+{
+    std::size_t code_points;
+    // Those outside the basic multilingual plane, which have four byte sequences.
+    std::size_t supplementary;
+};
+
+// Counts the code points in well-formed UTF-8 by counting lead bytes.
+inline _utf8_counts _count_utf8(const unsigned char* data, std::size_t size) noexcept
+{
+    _utf8_counts counts{ 0, 0 };
+    std::size_t i = 0;
+#if STRING_SIMD_SSE2
+    // As signed bytes, continuation bytes are those at most 0xBF, and four byte leads are those above 0xEF.
+    const __m128i continuation_limit = _mm_set1_epi8(char(0xBF));
+    const __m128i three_byte_limit = _mm_set1_epi8(char(0xEF));
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned leads = _mm_movemask_epi8(_mm_cmpgt_epi8(bytes, continuation_limit));
+        // Masking with the bytes themselves drops the non-negative, i.e. ASCII, bytes.
+        unsigned four_byte_leads = _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(bytes, three_byte_limit), bytes));
+        counts.code_points += std::popcount(leads);
+        counts.supplementary += std::popcount(four_byte_leads);
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        counts.code_points += (data[i] & 0xC0) != 0x80;
+        counts.supplementary += data[i] >= 0xF0;
+    }
+    return counts;
+}
+
+// Returns the number of `_to_t` code units needed to transcode the input, replacing ill-formed sequences.
+template <_unicode_char _to_t, _unicode_char _from_t>
+constexpr std::size_t _transcoded_length(const _from_t* data, std::size_t size) noexcept
+{
+    if !consteval
+    {
+        if constexpr (sizeof(_from_t) == 1 && sizeof(_to_t) > 1)
+        {
+            // Well-formed UTF-8 can be measured without decoding it.
+            auto bytes = reinterpret_cast<const unsigned char*>(data);
+            if (_validate_utf8_runtime(bytes, size) == _utf8_valid)
+            {
+                auto counts = _count_utf8(bytes, size);
+                return sizeof(_to_t) == 2 ? counts.code_points + counts.supplementary : counts.code_points;
+            }
+        }
+    }
+
+    std::size_t length = 0;
+    for (std::size_t i = 0; i < size;)
+    {
+        if !consteval
+        {
+            if (_code_unit(data[i]) < 0x80)
+            {
+                std::size_t run = _ascii_prefix_length(data + i, size - i);
+                length += run;
+                i += run;
+                continue;
+            }
+        }
+        auto decoded = _decode(data, size, i);
+        length += _encoded_length<_to_t>(decoded.code_point);
+        i += decoded.length;
+    }
+    return length;
+}
+
+// Transcodes the input into exactly `_transcoded_length` code units, returning that length.
+template <_unicode_char _to_t, _unicode_char _from_t>
+constexpr std::size_t _transcode(const _from_t* data, std::size_t size, _to_t* destination) noexcept
+{
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < size;)
+    {
+        if !consteval
+        {
+            if (_code_unit(data[i]) < 0x80)
+            {
+                std::size_t run = _copy_ascii(data + i, size - i, destination + written);
+                written += run;
+                i += run;
+                continue;
+            }
+        }
+        auto decoded = _decode(data, size, i);
+        written += _encode(decoded.code_point, destination + written);
+        i += decoded.length;
+    }
+    return written;
+}
+
+// Appends the transcoded input to the string, allocating at most once.
+// Nothing is appended if the result would not fit in the string.
+template <typename _string_t, _unicode_char _from_t>
+constexpr void _append_transcoded(_string_t& string, const _from_t* data, std::size_t size)
+{
+    _append_overwrite(string, _transcoded_length<typename _string_t::value_type>(data, size),
+        [data, size](auto* elements) { _transcode(data, size, elements); });
+}
+
+// Returns the number of UTF-8 code units needed to transcode the view.
+template <_unicode_char _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr std::size_t utf8_length(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    return _transcoded_length<char8_t>(view.data(), view.size());
+}
+
+// Returns the number of UTF-16 code units needed to transcode the view.
+template <_unicode_char _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr std::size_t utf16_length(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    return _transcoded_length<char16_t>(view.data(), view.size());
+}
+
+// Returns the number of UTF-32 code units, i.e. code points, needed to transcode the view.
+template <_unicode_char _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr std::size_t utf32_length(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    return _transcoded_length<char32_t>(view.data(), view.size());
+}
+
+// Transcodes the view to UTF-8, replacing each ill-formed sequence with U+FFFD.
+// Returns an empty string if the result would not fit.
+template <typename _string_t = u8string, _unicode_char _char_t, typename _size_t, typename _traits_t>
+    requires _utf8_char<typename _string_t::value_type>
+[[nodiscard]] constexpr _string_t to_utf8(basic_string_view<_char_t, _size_t, _traits_t> view)
+{
+    _string_t string;
+    _append_transcoded(string, view.data(), view.size());
+    return string;
+}
+
+// Transcodes the string to UTF-8, replacing each ill-formed sequence with U+FFFD.
+// Returns an empty string if the result would not fit.
+template <typename _string_t = u8string, _unicode_char _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+    requires _utf8_char<typename _string_t::value_type>
+[[nodiscard]] constexpr _string_t to_utf8(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string)
+{
+    return to_utf8<_string_t>(basic_string_view<_char_t, _size_t, _traits_t>(string));
+}
+
+// Transcodes the view to UTF-16, replacing each ill-formed sequence with U+FFFD.
+// Returns an empty string if the result would not fit.
+template <typename _string_t = u16string, _unicode_char _char_t, typename _size_t, typename _traits_t>
+    requires std::same_as<typename _string_t::value_type, char16_t>
+[[nodiscard]] constexpr _string_t to_utf16(basic_string_view<_char_t, _size_t, _traits_t> view)
+{
+    _string_t string;
+    _append_transcoded(string, view.data(), view.size());
+    return string;
+}
+
+// Transcodes the string to UTF-16, replacing each ill-formed sequence with U+FFFD.
+// Returns an empty string if the result would not fit.
+template <typename _string_t = u16string, _unicode_char _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+    requires std::same_as<typename _string_t::value_type, char16_t>
+[[nodiscard]] constexpr _string_t to_utf16(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string)
+{
+    return to_utf16<_string_t>(basic_string_view<_char_t, _size_t, _traits_t>(string));
+}
+
+// Transcodes the view to UTF-32, replacing each ill-formed sequence with U+FFFD.
+// Returns an empty string if the result would not fit.
+template <typename _string_t = u32string, _unicode_char _char_t, typename _size_t, typename _traits_t>
+    requires std::same_as<typename _string_t::value_type, char32_t>
+[[nodiscard]] constexpr _string_t to_utf32(basic_string_view<_char_t, _size_t, _traits_t> view)
+{
+    _string_t string;
+    _append_transcoded(string, view.data(), view.size());
+    return string;
+}
+
+// Transcodes the string to UTF-32, replacing each ill-formed sequence with U+FFFD.
+// Returns an empty string if the result would not fit.
+template <typename _string_t = u32string, _unicode_char _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+    requires std::same_as<typename _string_t::value_type, char32_t>
+[[nodiscard]] constexpr _string_t to_utf32(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string)
+{
+    return to_utf32<_string_t>(basic_string_view<_char_t, _size_t, _traits_t>(string));
+}
+
+// Transcodes a Latin-1 (ISO-8859-1) view to UTF-8.
+// Returns an empty string if the result would not fit.
+template <typename _string_t = u8string, typename _size_t, typename _traits_t>
+    requires _utf8_char<typename _string_t::value_type>
+[[nodiscard]] constexpr _string_t latin1_to_utf8(basic_string_view<char, _size_t, _traits_t> view)
+{
+    using to_type = typename _string_t::value_type;
+    const char* data = view.data();
+    std::size_t size = view.size();
+
+    // Every byte above 0x7F becomes two bytes.
+    std::size_t length = size;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if !consteval
+        {
+            i += _ascii_prefix_length(data + i, size - i);
+            if (i == size)
+                break;
+        }
+        length += _code_unit(data[i]) >= 0x80;
+    }
+
+    _string_t string;
+    if (length <= string.max_size())
+    {
+        string.resize_and_overwrite(static_cast<typename _string_t::size_type>(length), [data, size](to_type* destination, auto)
+        {
+            std::size_t written = 0;
+            for (std::size_t i = 0; i < size;)
+            {
+                if !consteval
+                {
+                    std::size_t run = _copy_ascii(data + i, size - i, destination + written);
+                    written += run;
+                    i += run;
+                    if (i == size)
+                        break;
+                }
+                written += _encode(_code_unit(data[i++]), destination + written);
+            }
+            return written;
+        });
+    }
+    return string;
+}
+
+// Transcodes a UTF-8 view to Latin-1 (ISO-8859-1), replacing each code point
+// above U+00FF and each ill-formed sequence with a question mark.
+// Returns an empty string if the result would not fit.
+template <typename _string_t = string, _utf8_char _char_t, typename _size_t, typename _traits_t>
+    requires std::same_as<typename _string_t::value_type, char>
+[[nodiscard]] constexpr _string_t utf8_to_latin1(basic_string_view<_char_t, _size_t, _traits_t> view)
+{
+    const _char_t* data = view.data();
+    std::size_t size = view.size();
+    std::size_t length = _transcoded_length<char32_t>(data, size);
+
+    _string_t string;
+    if (length <= string.max_size())
+    {
+        string.resize_and_overwrite(static_cast<typename _string_t::size_type>(length), [data, size](char* destination, auto)
+        {
+            std::size_t written = 0;
+            for (std::size_t i = 0; i < size;)
+            {
+                if !consteval
+                {
+                    std::size_t run = _copy_ascii(data + i, size - i, destination + written);
+                    written += run;
+                    i += run;
+                    if (i == size)
+                        break;
+                }
+                auto decoded = _utf8_decode(data, size, i);
+                destination[written++] = decoded.code_point <= 0xFF ? static_cast<char>(decoded.code_point) : '?';
+                i += decoded.length;
+            }
+            return written;
+        });
+    }
+    return string;
+}
+
+// Transcodes input that arrives in chunks, appending it to a `_string_t`.
+// A sequence split across chunks is held back until the rest of it arrives.
+template <typename _string_t, _unicode_char _from_t>
+    requires _unicode_char<typename _string_t::value_type>
+class basic_transcoder
+{
+public:
+    using string_type = _string_t;
+    using value_type = _from_t;
+
+private:
+    using to_type = typename string_type::value_type;
+    // The longest sequence in the source encoding.
+    static constexpr std::size_t _max_sequence_length = 4 / sizeof(value_type);
+
+public:
+    // Transcodes the chunk and appends it to the destination.
+    template <typename _size_t, typename _traits_t>
+    constexpr void append(string_type& destination, basic_string_view<value_type, _size_t, _traits_t> chunk)
+    {
+        const value_type* data = chunk.data();
+        std::size_t size = chunk.size();
+
+        if (_pending_size != 0)
+        {
+            // Complete the held back sequence with the start of this chunk.
+            // Fewer units than a whole sequence are ever held back, which the clamp makes visible to the compiler.
+            std::size_t pending = std::min<std::size_t>(_pending_size, _max_sequence_length - 1);
+            value_type joined[_max_sequence_length];
+            std::size_t taken = std::min(size, _max_sequence_length - pending);
+            std::copy_n(_pending, pending, joined);
+            std::copy_n(data, taken, joined + pending);
+
+            auto decoded = _decode(joined, pending + taken, 0);
+            if (decoded.truncated)
+            {
+                // The whole chunk still wasn't enough.
+                std::copy_n(data, taken, _pending + pending);
+                _pending_size = static_cast<std::uint8_t>(pending + taken);
+                return;
+            }
+            // The decoded sequence always covers at least the held back units.
+            _append_transcoded(destination, joined, decoded.length);
+            data += decoded.length - pending;
+            size -= decoded.length - pending;
+            _pending_size = 0;
+        }
+
+        std::size_t complete = _complete_length(data, size);
+        _append_transcoded(destination, data, complete);
+        std::copy_n(data + complete, size - complete, _pending);
+        _pending_size = static_cast<std::uint8_t>(size - complete);
+    }
+
+    // Transcodes the chunk and appends it to the destination.
+    template <typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+    constexpr void append(string_type& destination, const basic_string<value_type, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& chunk)
+    {
+        append(destination, basic_string_view<value_type, _size_t, _traits_t>(chunk));
+    }
+
+    // Ends the input, appending U+FFFD for a sequence that is still held back.
+    constexpr void finish(string_type& destination)
+    {
+        _append_transcoded(destination, _pending, _pending_size);
+        _pending_size = 0;
+    }
+
+    // Returns if part of a sequence is being held back.
+    [[nodiscard]] constexpr bool pending() const noexcept { return _pending_size != 0; }
+
+private:
+    // Returns the length of the chunk without a trailing truncated sequence.
+    static constexpr std::size_t _complete_length(const value_type* data, std::size_t size) noexcept
+    {
+        for (std::size_t back = 1; back < _max_sequence_length && back <= size; ++back)
+        {
+            std::size_t i = size - back;
+            if (_decode(data, size, i).truncated)
+                return i;
+            // Only continuation bytes can follow the start of a truncated sequence.
+            if (sizeof(value_type) != 1 || (_code_unit(data[i]) & 0xC0) != 0x80)
+                break;
+        }
+        return size;
+    }
+
+private:
+    value_type _pending[_max_sequence_length]{};
+    std::uint8_t _pending_size = 0;
+};
+
+// Transcodes chunked UTF-8 to UTF-16.
+using utf8_to_utf16_transcoder = basic_transcoder<u16string, char8_t>;
+// Transcodes chunked UTF-8 to UTF-32.
+using utf8_to_utf32_transcoder = basic_transcoder<u32string, char8_t>;
+// Transcodes chunked UTF-16 to UTF-8.
+using utf16_to_utf8_transcoder = basic_transcoder<u8string, char16_t>;
+// Transcodes chunked UTF-16 to UTF-32.
+using utf16_to_utf32_transcoder = basic_transcoder<u32string, char16_t>;
+
+// A lazy range over the code points of a view. Ill-formed sequences yield U+FFFD.
+template <_unicode_char _char_t, typename _size_t, typename _traits_t>
+class basic_code_point_view : public std::ranges::view_interface<basic_code_point_view<_char_t, _size_t, _traits_t>>
+{
+public:
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+    using size_type = _size_t;
+
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = char32_t;
+        using difference_type = std::ptrdiff_t;
+
+    public:
+        [[nodiscard]] constexpr iterator() noexcept = default;
+
+        [[nodiscard]] constexpr char32_t operator*() const noexcept { return _code_point; }
+
+        constexpr iterator& operator++() noexcept
+        {
+            _offset += _length;
+            _decode_current();
+            return *this;
+        }
+
+        constexpr iterator operator++(int) noexcept
+        {
+            iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const iterator& other) const noexcept { return _offset == other._offset; }
+
+        // Returns the offset of the first code unit of the current code point.
+        [[nodiscard]] constexpr size_type offset() const noexcept { return static_cast<size_type>(_offset); }
+
+        // Returns the code units of the current code point.
+        [[nodiscard]] constexpr string_view_type units() const noexcept { return { _data + _offset, static_cast<size_type>(_length) }; }
+
+    private:
+        friend class basic_code_point_view;
+
+        [[nodiscard]] constexpr iterator(const _char_t* data, std::size_t size, std::size_t offset) noexcept
+            : _data(data), _size(size), _offset(offset)
+        {
+            _decode_current();
+        }
+
+        constexpr void _decode_current() noexcept
+        {
+            if (_offset >= _size)
+                return;
+            if !consteval
+            {
+                // Find the whole ASCII run ahead at once, then step through it without decoding.
+                if (_ascii_end <= _offset && _code_unit(_data[_offset]) < 0x80)
+                    _ascii_end = _offset + _ascii_prefix_length(_data + _offset, _size - _offset);
+                if (_offset < _ascii_end)
+                {
+                    _code_point = _code_unit(_data[_offset]);
+                    _length = 1;
+                    return;
+                }
+            }
+            auto decoded = _decode(_data, _size, _offset);
+            _code_point = decoded.code_point;
+            _length = decoded.length;
+        }
+
+    private:
+        const _char_t* _data = nullptr;
+        std::size_t _size = 0;
+        std::size_t _offset = 0;
+        std::size_t _length = 0;
+        // The end of the ASCII run last found by the vectorized scan.
+        std::size_t _ascii_end = 0;
+        char32_t _code_point = 0;
+    };
+
+public:
+    [[nodiscard]] constexpr basic_code_point_view() noexcept = default;
+
+    [[nodiscard]] explicit constexpr basic_code_point_view(string_view_type view) noexcept
+        : _view(view) {}
+
+    [[nodiscard]] constexpr iterator begin() const noexcept { return { _view.data(), _view.size(), 0 }; }
+    [[nodiscard]] constexpr iterator end() const noexcept { return { _view.data(), _view.size(), _view.size() }; }
+
+    // Returns the underlying view.
+    [[nodiscard]] constexpr string_view_type base() const noexcept { return _view; }
+
+private:
+    string_view_type _view;
+};
+
+// Returns a lazy range over the code points of the view.
+template <_unicode_char _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr basic_code_point_view<_char_t, _size_t, _traits_t> code_points(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    return basic_code_point_view<_char_t, _size_t, _traits_t>(view);
+}
+
+// Returns a lazy range over the code points of the string.
+template <_unicode_char _char_t, typename _size_t, _size_t _min_internal_capacity, typename _traits_t, typename _allocator_t, string_layout _layout>
+[[nodiscard]] constexpr basic_code_point_view<_char_t, _size_t, _traits_t> code_points(const basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>& string) noexcept
+{
+    return basic_code_point_view<_char_t, _size_t, _traits_t>(string);
+}
+
+// Returns the longest prefix of the view holding at most `count` code points.
+template <_unicode_char _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] constexpr basic_string_view<_char_t, _size_t, _traits_t> truncate_code_points(basic_string_view<_char_t, _size_t, _traits_t> view, std::size_t count) noexcept
+{
+    const _char_t* data = view.data();
+    std::size_t size = view.size();
+    std::size_t i = 0;
+    while (i < size && count != 0)
+    {
+        if !consteval
+        {
+            if (_code_unit(data[i]) < 0x80)
+            {
+                std::size_t run = _ascii_prefix_length(data + i, std::min(count, size - i));
+                i += run;
+                count -= run;
+                continue;
+            }
+        }
+        i += _decode(data, size, i).length;
+        --count;
+    }
+    return view.substr(0, static_cast<_size_t>(i));
+}
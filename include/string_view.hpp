@@ -1,8 +1,12 @@
 #pragma once
 
+#include "string_simd.hpp"
+#include <algorithm>
 #include <concepts>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <string_view>
 
 template
 <
@@ -110,7 +114,7 @@ public:
     {
         if (_size < offset)
             return _retain_empty();
-        return { _data + offset, std::min(_size - offset, count) };
+        return { _data + offset, std::min<size_type>(_size - offset, count) };
     }
 
     // Compares two views.
@@ -141,19 +145,129 @@ public:
     [[nodiscard]] constexpr bool ends_with(basic_string_view view) const noexcept
     { return view._size <= _size && substr(_size - view._size, view._size) == view; }
 
-    // TODO: contains
+    // Returns if this view contains the given view.
+    [[nodiscard]] constexpr bool contains(basic_string_view view) const noexcept { return find(view) != npos; }
 
-    // TODO: find
+    // Returns if this view contains the given character.
+    [[nodiscard]] constexpr bool contains(value_type element) const noexcept { return find(element) != npos; }
 
-    // TODO: rfind
+    // Returns the index of the first occurrence of the given view at or after `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type find(basic_string_view view, size_type offset = 0) const noexcept
+    {
+        if (_size < offset || _size - offset < view._size)
+            return npos;
+        if (view.empty())
+            return offset;
+
+        // Find candidates by their first character, then compare the rest.
+        const_pointer last = _data + (_size - view._size);
+        for (const_pointer candidate = _data + offset; candidate <= last; ++candidate)
+        {
+            candidate = traits_type::find(candidate, static_cast<std::size_t>(last - candidate) + 1, view._data[0]);
+            if (candidate == nullptr)
+                break;
+            if (traits_type::compare(candidate + 1, view._data + 1, view._size - 1) == 0)
+                return static_cast<size_type>(candidate - _data);
+        }
+        return npos;
+    }
+
+    // Returns the index of the first occurrence of the given character at or after `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type find(value_type element, size_type offset = 0) const noexcept
+    {
+        if (_size <= offset)
+            return npos;
+        const_pointer found = traits_type::find(_data + offset, _size - offset, element);
+        return found != nullptr ? static_cast<size_type>(found - _data) : npos;
+    }
+
+    // Returns the index of the last occurrence of the given view starting at or before `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type rfind(basic_string_view view, size_type offset = npos) const noexcept
+    {
+        if (_size < view._size)
+            return npos;
+        for (size_type i = std::min<size_type>(offset, _size - view._size); ; --i)
+        {
+            if (traits_type::compare(_data + i, view._data, view._size) == 0)
+                return i;
+            if (i == 0)
+                return npos;
+        }
+    }
+
+    // Returns the index of the last occurrence of the given character at or before `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type rfind(value_type element, size_type offset = npos) const noexcept
+    {
+        return rfind(basic_string_view(&element, 1), offset);
+    }
+
+    // Returns the index of the first character at or after `offset` that is in the given set, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_first_of(basic_string_view set, size_type offset = 0) const noexcept
+    {
+        size_type i = _skip_blocks<true>(set, offset);
+        for (; i < _size; ++i)
+            if (traits_type::find(set._data, set._size, _data[i]) != nullptr)
+                return i;
+        return npos;
+    }
+
+    // Returns the index of the first occurrence of the given character at or after `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_first_of(value_type element, size_type offset = 0) const noexcept
+    { return find(element, offset); }
+
+    // Returns the index of the first character at or after `offset` that is not in the given set, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_first_not_of(basic_string_view set, size_type offset = 0) const noexcept
+    {
+        for (size_type i = _skip_blocks<false>(set, offset); i < _size; ++i)
+            if (traits_type::find(set._data, set._size, _data[i]) == nullptr)
+                return i;
+        return npos;
+    }
+
+    // Returns the index of the first character at or after `offset` that is not the given character, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_first_not_of(value_type element, size_type offset = 0) const noexcept
+    { return find_first_not_of(basic_string_view(&element, 1), offset); }
+
+    // Returns the index of the last character at or before `offset` that is in the given set, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_last_of(basic_string_view set, size_type offset = npos) const noexcept
+    {
+        for (size_type i = _rskip_blocks<true>(set, offset); i < _size; --i)
+            if (traits_type::find(set._data, set._size, _data[i]) != nullptr)
+                return i;
+        return npos;
+    }
+
+    // Returns the index of the last occurrence of the given character at or before `offset`, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_last_of(value_type element, size_type offset = npos) const noexcept
+    { return rfind(element, offset); }
+
+    // Returns the index of the last character at or before `offset` that is not in the given set, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_last_not_of(basic_string_view set, size_type offset = npos) const noexcept
+    {
+        for (size_type i = _rskip_blocks<false>(set, offset); i < _size; --i)
+            if (traits_type::find(set._data, set._size, _data[i]) == nullptr)
+                return i;
+        return npos;
+    }
+
+    // Returns the index of the last character at or before `offset` that is not the given character, or npos if there is none.
+    [[nodiscard]] constexpr size_type find_last_not_of(value_type element, size_type offset = npos) const noexcept
+    { return find_last_not_of(basic_string_view(&element, 1), offset); }
 
-    // TODO: find_first_of
+    // Returns a new view without the leading characters that are in the given set.
+    [[nodiscard]] constexpr basic_string_view trim_left(basic_string_view set = whitespace()) const noexcept
+    { return remove_prefix(std::min(find_first_not_of(set), _size)); }
 
-    // TODO: find_first_not_of
+    // Returns a new view without the trailing characters that are in the given set.
+    [[nodiscard]] constexpr basic_string_view trim_right(basic_string_view set = whitespace()) const noexcept
+    { return substr(0, static_cast<size_type>(find_last_not_of(set) + 1)); }
 
-    // TODO: fint_last_of
+    // Returns a new view without the leading and trailing characters that are in the given set.
+    [[nodiscard]] constexpr basic_string_view trim(basic_string_view set = whitespace()) const noexcept
+    { return trim_right(set).trim_left(set); }
 
-    // TODO: find_last_not_of
+    // Returns the characters trimmed by default: space, tab, and the line and page breaks.
+    [[nodiscard]] static constexpr basic_string_view whitespace() noexcept { return { _whitespace, 6 }; }
 
 public:
     [[nodiscard]] constexpr const_iterator begin() const noexcept { return const_iterator(_data); }
@@ -170,6 +284,36 @@ private:
     // For better debugging.
     constexpr basic_string_view _retain_empty() const noexcept { return { _data, 0 }; }
 
+    // Returns where to start searching forward from `offset` for a character that is (or, if not `_in_set`, isn't) in the set,
+    // skipping the blocks before it. Only small sets are searched a block at a time, and only if the traits compare characters as they are.
+    template <bool _in_set>
+    constexpr size_type _skip_blocks(basic_string_view set, size_type offset) const noexcept
+    {
+        if !consteval
+        {
+            if constexpr (std::is_same_v<traits_type, std::char_traits<value_type>>)
+                if (offset < _size && set._size <= 16)
+                    return offset + static_cast<size_type>(_find_any_blocks<_in_set>(_data + offset, _size - offset, set._data, set._size));
+        }
+        return offset;
+    }
+
+    // Returns where to start searching backward from `offset`, like _skip_blocks. The result is npos if there's nothing to search.
+    template <bool _in_set>
+    constexpr size_type _rskip_blocks(basic_string_view set, size_type offset) const noexcept
+    {
+        size_type end = offset < _size ? offset + 1 : _size;
+        if !consteval
+        {
+            if constexpr (std::is_same_v<traits_type, std::char_traits<value_type>>)
+                if (set._size <= 16)
+                    end = static_cast<size_type>(_rfind_any_blocks<_in_set>(_data, end, set._data, set._size));
+        }
+        return end - 1;
+    }
+
+    static constexpr value_type _whitespace[] = { value_type(' '), value_type('\t'), value_type('\n'), value_type('\v'), value_type('\f'), value_type('\r') };
+
 private:
     const_pointer _data;
     size_type _size;
@@ -198,13 +342,35 @@ constexpr std::strong_ordering operator<=>(
             std::strong_ordering::greater;
 }
 
+// Hashes the characters of a view. Traits providing their own `hash`, such as
+// case-insensitive ones, are used so that views comparing equal hash equally.
+template <typename _char_t, typename _size_t, typename _traits_t>
+[[nodiscard]] std::size_t _hash_string(basic_string_view<_char_t, _size_t, _traits_t> view) noexcept
+{
+    if constexpr (requires { { _traits_t::hash(view.data(), std::size_t()) } -> std::convertible_to<std::size_t>; })
+        return _traits_t::hash(view.data(), view.size());
+    else
+        return std::hash<std::basic_string_view<_char_t>>()({ view.data(), view.size() });
+}
+
+template <typename _char_t, typename _size_t, typename _traits_t>
+struct std::hash<::basic_string_view<_char_t, _size_t, _traits_t>>
+{
+    [[nodiscard]] std::size_t operator()(::basic_string_view<_char_t, _size_t, _traits_t> view) const noexcept { return _hash_string(view); }
+};
+
 using string_view = basic_string_view<char, std::size_t>;
 using small_string_view = basic_string_view<char, std::uint8_t>;
+using compact_string_view = basic_string_view<char, std::uint32_t>;
 using u8string_view = basic_string_view<char8_t, std::size_t>;
 using small_u8string_view = basic_string_view<char8_t, std::uint8_t>;
+using compact_u8string_view = basic_string_view<char8_t, std::uint32_t>;
 using u16string_view = basic_string_view<char16_t, std::size_t>;
 using small_u16string_view = basic_string_view<char16_t, std::uint8_t>;
+using compact_u16string_view = basic_string_view<char16_t, std::uint32_t>;
 using u32string_view = basic_string_view<char32_t, std::size_t>;
 using small_u32string_view = basic_string_view<char32_t, std::uint8_t>;
+using compact_u32string_view = basic_string_view<char32_t, std::uint32_t>;
 using wstring_view = basic_string_view<wchar_t, std::size_t>;
 using small_wstring_view = basic_string_view<wchar_t, std::uint8_t>;
+using compact_wstring_view = basic_string_view<wchar_t, std::uint32_t>;
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "string_charconv.hpp"
+#include <cerrno>
+#include <unistd.h>
+
+// A lightweight output sink, either appending to a string or writing to a file descriptor through its own buffer.
+// Unlike a std::ostream, there is no locale, formatting state or virtual dispatch per insertion.
+template
+<
+    typename _char_t,
+    typename _size_t = std::size_t,
+    _size_t _min_internal_capacity = 15 / sizeof(_char_t),
+    typename _traits_t = std::char_traits<_char_t>,
+    typename _allocator_t = STRING_DEFAULT_ALLOCATOR,
+    string_layout _layout = string_layout::standard
+>
+class basic_string_writer
+{
+public:
+    using string_type = basic_string<_char_t, _size_t, _min_internal_capacity, _traits_t, _allocator_t, _layout>;
+    using string_view_type = basic_string_view<_char_t, _size_t, _traits_t>;
+    using value_type = _char_t;
+    using size_type = _size_t;
+
+    static constexpr std::size_t default_buffer_size = 64 * 1024;
+
+public:
+    // Appends to the string, which must outlive the writer.
+    [[nodiscard]] explicit basic_string_writer(string_type& destination) noexcept
+        : _string(std::addressof(destination)) {}
+
+    // Writes to a file descriptor, which is not closed by the writer.
+    // Writes are buffered until the buffer fills, flush() is called or the writer is destroyed.
+    [[nodiscard]] explicit basic_string_writer(int descriptor, size_type buffer_size = default_buffer_size) requires (sizeof(_char_t) == 1)
+        : _string(std::addressof(_buffer)), _descriptor(descriptor)
+    {
+        _buffer.reserve(buffer_size);
+    }
+
+    // The destination is referred to by address, so the writer can't be copied or moved.
+    basic_string_writer(const basic_string_writer&) = delete;
+    basic_string_writer& operator=(const basic_string_writer&) = delete;
+
+    ~basic_string_writer() noexcept { flush(); }
+
+public:
+    // Writes the characters.
+    basic_string_writer& write(string_view_type view)
+    {
+        if (_buffered() && _buffer.capacity() - _buffer.size() < view.size())
+        {
+            flush();
+            // Too large to buffer, so skip the copy.
+            if (_buffer.capacity() <= view.size())
+            {
+                _write(view.data(), view.size());
+                return *this;
+            }
+        }
+        _append_overwrite(*_string, view.size(), [view](_char_t* elements) { _traits_t::copy(elements, view.data(), view.size()); });
+        return *this;
+    }
+
+    // Writes the character.
+    basic_string_writer& put(value_type element)
+    {
+        _make_room(1);
+        _append_overwrite(*_string, 1, [element](_char_t* elements) { *elements = element; });
+        return *this;
+    }
+
+    // Writes the buffered characters to the file descriptor, if there is one.
+    void flush() noexcept
+    {
+        if (_buffered() && !_buffer.empty())
+        {
+            _write(_buffer.data(), _buffer.size());
+            _buffer.clear();
+        }
+    }
+
+    // Returns the errno value of the last failure to write to the file descriptor, or 0.
+    [[nodiscard]] int error() const noexcept { return _error; }
+
+public:
+    basic_string_writer& operator<<(string_view_type view) { return write(view); }
+    basic_string_writer& operator<<(const string_type& string) { return write(string); }
+    basic_string_writer& operator<<(const value_type* elements) { return write(elements); }
+    basic_string_writer& operator<<(value_type element) { return put(element); }
+
+    template <_integer _value_t>
+        requires (!std::same_as<_value_t, value_type>)
+    basic_string_writer& operator<<(_value_t value)
+    {
+        // Enough for any 64-bit integer and its sign.
+        _make_room(20);
+        append_integer(*_string, value);
+        return *this;
+    }
+
+    template <std::floating_point _value_t>
+    basic_string_writer& operator<<(_value_t value)
+    {
+        // Enough for any shortest long double.
+        _make_room(48);
+        append_float(*_string, value);
+        return *this;
+    }
+
+private:
+    // Returns if the writer writes to a file descriptor through its buffer.
+    bool _buffered() const noexcept { return _string == std::addressof(_buffer); }
+
+    // Flushes the buffer if fewer than `count` characters would fit.
+    void _make_room(std::size_t count) noexcept
+    {
+        if (_buffered() && _buffer.capacity() - _buffer.size() < count)
+            flush();
+    }
+
+    void _write(const _char_t* data, std::size_t size) noexcept
+    {
+        while (size != 0)
+        {
+            ssize_t count = ::write(_descriptor, data, size);
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                _error = errno;
+                return;
+            }
+            data += count;
+            size -= static_cast<std::size_t>(count);
+        }
+    }
+
+private:
+    string_type _buffer;
+    string_type* _string;
+    int _descriptor = -1;
+    int _error = 0;
+};
+
+using string_writer = basic_string_writer<char>;
+using u8string_writer = basic_string_writer<char8_t>;
+using u16string_writer = basic_string_writer<char16_t>;
+using u32string_writer = basic_string_writer<char32_t>;
+using wstring_writer = basic_string_writer<wchar_t>;
@@ -0,0 +1,130 @@
+#include "common.hpp"
+#include "string_builder.hpp"
+#include <string>
+#include <unistd.h>
+
+static std::string ReadAll(int descriptor)
+{
+    std::string contents;
+    char buffer[256];
+    for (ssize_t count; (count = ::read(descriptor, buffer, sizeof(buffer))) > 0; )
+        contents.append(buffer, static_cast<std::size_t>(count));
+    return contents;
+}
+
+TEST(StringBuilder, Coalescing) {
+    {
+        string_builder builder;
+        builder << "GET " << string_view("/index.html") << ' ' << "HTTP/1.1" << string(Small1);
+
+        ASSERT_EQ(builder.size(), 29u);
+        ASSERT_EQ(builder.iovecs().size(), 1u);
+        ASSERT_EQ(builder.to_string(), string_view("GET /index.html HTTP/1.1small"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringBuilder, Coalescing_NarrowSize) {
+    {
+        basic_string_builder<char, std::uint8_t> builder;
+        std::string piece(31, 'p');
+        for (int i = 0; i < 4; ++i)
+            builder.append_copy(basic_string_view<char, std::uint8_t>(piece.data(), 31));
+
+        ASSERT_EQ(builder.size(), 124u);
+        ASSERT_EQ(builder.iovecs().size(), 1u);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringBuilder, Borrowed) {
+    {
+        std::string body(100, 'b');
+        string_builder builder;
+        builder << "header: " << string_view(body.data(), body.size()) << "\r\n";
+
+        auto iovecs = builder.iovecs();
+        ASSERT_EQ(iovecs.size(), 3u);
+        ASSERT_EQ(iovecs[1].iov_base, body.data());
+        ASSERT_EQ(iovecs[1].iov_len, 100u);
+        ASSERT_EQ(builder.size(), 110u);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringBuilder, Owned) {
+    {
+        string_builder builder;
+        {
+            string s1(std::string(80, 'o').c_str());
+            const char* data = s1.data();
+            builder << "[" << std::move(s1) << "]";
+
+            ASSERT_EQ(builder.iovecs()[1].iov_base, data);
+        }
+        ASSERT_EQ(builder.to_string(), string_view(("[" + std::string(80, 'o') + "]").c_str()));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringBuilder, Flatten) {
+    {
+        std::string body(100, 'x');
+        string_builder builder;
+        builder << Large1 << string_view(body.data(), body.size()) << Large2;
+
+        string s1("prefix ");
+        builder.append_to(s1);
+        string s2 = builder.to_string();
+
+        std::string expected = std::string(Large1.data()) + body + Large2.data();
+        ASSERT_EQ(string_view(s1), string_view(("prefix " + expected).c_str()));
+        ASSERT_EQ(string_view(s2), string_view(expected.c_str()));
+        // Allocated once, to the exact size.
+        ASSERT_EQ(s2.capacity(), expected.size());
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringBuilder, Clear) {
+    {
+        string_builder builder;
+        builder << Large1 << string(Large2);
+        builder.clear();
+
+        ASSERT_TRUE(builder.empty());
+        ASSERT_TRUE(builder.iovecs().empty());
+        AssertEmpty(builder.to_string());
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringBuilder, Write) {
+    {
+        int pipe_descriptors[2];
+        ASSERT_EQ(::pipe(pipe_descriptors), 0);
+        std::string body(200, 'w');
+        std::string expected;
+        string_builder builder;
+        for (int i = 0; i < 10; ++i)
+        {
+            builder << "piece " << string_view(body.data(), body.size());
+            expected += "piece " + body;
+        }
+
+        ASSERT_TRUE(builder.write(pipe_descriptors[1]));
+        ::close(pipe_descriptors[1]);
+
+        ASSERT_EQ(ReadAll(pipe_descriptors[0]), expected);
+        ::close(pipe_descriptors[0]);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringBuilder, Write_Invalid) {
+    string_builder builder;
+    builder << Small1;
+
+    ASSERT_FALSE(builder.write(-1));
+    ASSERT_EQ(builder.error(), EBADF);
+}
@@ -0,0 +1,71 @@
+#include "common.hpp"
+#include "string_traits.hpp"
+#include <map>
+#include <unordered_map>
+
+TEST(StringCaseInsensitiveTraits, Compare) {
+    {
+        ci_string s1("Content-Length");
+        ci_string s2("CONTENT-length");
+        ci_string s3("Content-Type");
+
+        ASSERT_TRUE(s1 == s2);
+        ASSERT_TRUE(s1 < s3);
+        ASSERT_TRUE(s1 == ci_string_view("content-length"));
+        ASSERT_EQ(ci_string_view("a long enough key to fill a whole block: A").compare(ci_string_view("A LONG ENOUGH KEY TO FILL A WHOLE BLOCK: b")), -1);
+        ASSERT_FALSE(ci_string_view("@") == ci_string_view("`"));
+        // Letters order as lowercase, so unlike bytewise, "_" orders before "Z".
+        ASSERT_TRUE(ci_string_view("_") < ci_string_view("Z"));
+        ASSERT_TRUE(s1.starts_with(ci_string_view("CONTENT-")));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringCaseInsensitiveTraits, Find) {
+    ci_string_view haystack = "Host: example.com\r\nContent-Type: text/plain\r\nX-Forwarded-For: 10.0.0.1\r\n";
+
+    ASSERT_EQ(haystack.find(ci_string_view("content-type")), 19ul);
+    ASSERT_EQ(haystack.find(ci_string_view("X-FORWARDED-FOR")), 45ul);
+    ASSERT_EQ(haystack.find('x'), 7ul);
+    ASSERT_EQ(haystack.find('X', 8), 35ul);
+    ASSERT_EQ(haystack.rfind(ci_string_view("HOST")), 0ul);
+    ASSERT_EQ(haystack.find_first_of(ci_string_view("P")), 10ul);
+    ASSERT_FALSE(haystack.contains(ci_string_view("cookie")));
+}
+
+TEST(StringCaseInsensitiveTraits, Hash) {
+    std::hash<ci_string_view> hash;
+
+    ASSERT_EQ(hash("Content-Length"), hash("CONTENT-LENGTH"));
+    ASSERT_EQ(hash("x-a-much-longer-header-name"), hash("X-A-MUCH-LONGER-HEADER-NAME"));
+    ASSERT_NE(hash("content-length"), hash("content-type"));
+    ASSERT_NE(hash("@"), hash("`"));
+    ASSERT_EQ(std::hash<ci_u8string_view>()(u8"Été Sum"), std::hash<ci_u8string_view>()(u8"ÉTé sUM"));
+}
+
+TEST(StringCaseInsensitiveTraits, MapKeys) {
+    {
+        std::map<ci_string, int, std::less<>> ordered;
+        ordered.emplace("Accept", 1);
+        ordered.emplace("Content-Length", 2);
+
+        ASSERT_EQ(ordered.at("ACCEPT"), 1);
+        ASSERT_EQ(ordered.find(ci_string_view("content-length"))->second, 2);
+        ASSERT_FALSE(ordered.emplace("accept", 3).second);
+
+        std::unordered_map<ci_string, int, std::hash<ci_string>, std::equal_to<>> unordered;
+        unordered.emplace("Accept", 1);
+        unordered.emplace("A-Header-Name-Long-Enough-To-Allocate", 2);
+
+        ASSERT_EQ(unordered.find(ci_string_view("accept"))->second, 1);
+        ASSERT_EQ(unordered.find(ci_string_view("a-header-name-long-enough-to-allocate"))->second, 2);
+        ASSERT_EQ(unordered.find(ci_string_view("Content-Length")), unordered.end());
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringCaseInsensitiveTraits, Constexpr) {
+    static_assert(ci_string_view("GET") == ci_string_view("get"));
+    static_assert(ci_string_view("Hello World").find(ci_string_view("WORLD")) == 6);
+    static_assert(ci_string("Abc") < ci_string("abd"));
+}
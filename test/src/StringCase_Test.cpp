@@ -0,0 +1,125 @@
+#include "common.hpp"
+#include "string_case.hpp"
+
+TEST(StringCase, ToLower_Small) {
+    {
+        string s1("HeLLo");
+
+        to_lower(s1);
+
+        AssertSmall(s1, "hello");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringCase, ToUpper_Large) {
+    {
+        string s1("Content-Type: text/html; charset=utf-8 [@`{~]");
+
+        to_upper(s1);
+
+        AssertLarge(s1, "CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8 [@`{~]");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringCase, ToLower_CharIsAsciiOnly) {
+    {
+        string s1("\xC3\x89T\xC3\x89 AND SOME MORE TEXT");
+
+        to_lower(s1);
+
+        AssertLarge(s1, "\xC3\x89t\xC3\x89 and some more text");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringCase, ToLower_Unicode) {
+    {
+        u8string s1(u8"ÉTÉ ΣΟΦΊΑ ДОМ AND A LONG ASCII TAIL");
+        u16string s2(u"ÉTÉ ΣΟΦΊΑ ДОМ AND A LONG ASCII TAIL");
+
+        to_lower(s1);
+        to_lower(s2);
+
+        ASSERT_EQ(u8string_view(s1), u8string_view(u8"été σοφία дом and a long ascii tail"));
+        ASSERT_EQ(u16string_view(s2), u16string_view(u"été σοφία дом and a long ascii tail"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringCase, ToUpper_Unicode_LengthChanges) {
+    {
+        // U+0250 takes 2 bytes, but its uppercase U+2C6F takes 3.
+        u8string s1(u8"abc \u0250 def");
+        // U+212A KELVIN SIGN takes 3 bytes, but its lowercase takes 1.
+        u8string s2(u8"10 \u212A and more");
+
+        to_upper(s1);
+        to_lower(s2);
+
+        ASSERT_EQ(u8string_view(s1), u8string_view(u8"ABC \u2C6F DEF"));
+        ASSERT_EQ(u8string_view(s2), u8string_view(u8"10 k and more"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringCase, ToLower_IntoDestination) {
+    {
+        string s1("some previous contents");
+        const char* allocation = s1.data();
+
+        to_lower(string_view("GET /Index.HTML"), s1);
+
+        ASSERT_EQ(string_view(s1), string_view("get /index.html"));
+        ASSERT_EQ(s1.data(), allocation);
+
+        u8string s2;
+        to_upper(u8string_view(u8"straße"), s2);
+
+        ASSERT_EQ(u8string_view(s2), u8string_view(u8"STRAßE"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringCase, IEquals) {
+    ASSERT_TRUE(iequals(string_view("Content-Length"), string_view("content-LENGTH")));
+    ASSERT_TRUE(iequals(Large1, Large1));
+    ASSERT_FALSE(iequals(string_view("Content-Length"), string_view("Content-Lengths")));
+    ASSERT_FALSE(iequals(string_view("a long header name that differs at the end: x"), string_view("A LONG HEADER NAME THAT DIFFERS AT THE END: Y")));
+    ASSERT_FALSE(iequals(string_view("@"), string_view("`")));
+    ASSERT_TRUE(iequals(u8string_view(u8"ΣΟΦΊΑ and KELVIN"), u8string_view(u8"σοφία AND \u212Aelvin")));
+    ASSERT_TRUE(iequals(u16string_view(u"ÉTÉ"), u16string_view(u"été")));
+}
+
+TEST(StringCase, ICompare) {
+    ASSERT_EQ(icompare(string_view("abc"), string_view("ABC")), 0);
+    ASSERT_LT(icompare(string_view("abc"), string_view("ABD")), 0);
+    ASSERT_GT(icompare(string_view("abcd"), string_view("ABC")), 0);
+    ASSERT_LT(icompare(string_view("ABC"), string_view("abcd")), 0);
+    ASSERT_GT(icompare(string_view("a long enough prefix to fill a block: b"), string_view("A LONG ENOUGH PREFIX TO FILL A BLOCK: A")), 0);
+    ASSERT_LT(icompare(u8string_view(u8"été"), u8string_view(u8"ÉTÉS")), 0);
+}
+
+TEST(StringCase, IFind) {
+    string_view haystack = "Host: example.com\r\nContent-Type: text/plain\r\nX-Forwarded-For: 10.0.0.1\r\n";
+
+    ASSERT_EQ(ifind(haystack, string_view("content-type")), 19ul);
+    ASSERT_EQ(ifind(haystack, string_view("X-FORWARDED-FOR")), 45ul);
+    ASSERT_EQ(ifind(haystack, string_view("HOST"), 1ul), string_view::npos);
+    ASSERT_EQ(ifind(haystack, string_view("cookie")), string_view::npos);
+    ASSERT_EQ(ifind(haystack, string_view()), 0ul);
+    ASSERT_EQ(ifind(u8string_view(u8"Temperature in \u212Aelvin"), u8string_view(u8"KELVIN")), 15ul);
+    ASSERT_EQ(ifind(u8string_view(u8"le café CAFÉ"), u8string_view(u8"CAFÉ")), 3ul);
+    ASSERT_EQ(ifind(u8string_view(u8"le café CAFÉ"), u8string_view(u8"CAFÉ"), 4ul), 9ul);
+}
+
+TEST(StringCase, Constexpr) {
+    static_assert(iequals(u8string_view(u8"ÉTÉ"), u8string_view(u8"été")));
+    static_assert(ifind(string_view("abcABC"), string_view("Ca")) == 2);
+    static_assert([] {
+        u8string s1(u8"ÉTÉ");
+        to_lower(s1);
+        return u8string_view(s1) == u8string_view(u8"été");
+    }());
+}
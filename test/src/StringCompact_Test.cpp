@@ -0,0 +1,60 @@
+#include "common.hpp"
+#include <cstdint>
+
+TEST(StringCompact, Layout) {
+    constexpr auto layout = compact_string::layout_info();
+
+    // Half the size of the std::size_t fields, with the same small buffer, in three quarters of the object.
+    static_assert(sizeof(compact_string) == 24 && compact_string::sboc == string::sboc);
+    static_assert(layout.size_offset == 16 && layout.capacity_offset == 20 && layout.padding == 0);
+    static_assert(compact_u16string::sboc == 7 && sizeof(compact_u16string) == 24);
+    static_assert(sizeof(compact_string_view) == 16);
+    ASSERT_EQ(compact_string().max_size(), std::size_t(INT32_MAX) - 1);
+}
+
+TEST(StringCompact, Grow) {
+    {
+        compact_string s1;
+        std::uint32_t allocations = 0;
+        for (std::uint32_t i = 0; i < 1000; ++i)
+        {
+            auto old_capacity = s1.capacity();
+            s1.insert(s1.size(), 1, static_cast<char>('a' + i % 26));
+            allocations += s1.capacity() != old_capacity;
+        }
+
+        ASSERT_EQ(s1.size(), 1000u);
+        ASSERT_EQ(s1[999], 'a' + 999 % 26);
+        ASSERT_EQ(s1.c_str()[1000], '\0');
+        // Doubling from the small buffer.
+        ASSERT_EQ(allocations, 7u);
+
+        s1.erase(10, compact_string::npos, erase_policy::shrink_to_small);
+        ASSERT_TRUE(s1.small());
+        ASSERT_EQ(compact_string_view(s1), compact_string_view("abcdefghij"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringCompact, ReserveBeyondMaxSize) {
+    {
+        compact_string s1(compact_string_view("small"));
+        s1.reserve(UINT32_MAX);
+        s1.reserve(static_cast<std::uint32_t>(s1.max_size() + 1));
+        ASSERT_TRUE(s1.small());
+        ASSERT_EQ(s1.capacity(), compact_string::sboc);
+
+        small_string s2;
+        s2.reserve(200);
+        ASSERT_TRUE(s2.small());
+        // Bounding the fill by the capacity lets the compiler see it stays within the buffer it was given.
+        s2.resize_and_overwrite(200, [&s2](char* elements, std::uint8_t count)
+        {
+            std::fill_n(elements, std::min(count, s2.capacity()), 'x');
+            return count;
+        });
+        ASSERT_EQ(s2.size(), s2.max_size());
+        ASSERT_EQ(s2.c_str()[s2.size()], '\0');
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
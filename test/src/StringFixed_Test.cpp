@@ -0,0 +1,50 @@
+#include "common.hpp"
+#include "string_fixed.hpp"
+
+template <basic_fixed_string _key>
+static constexpr string_view KeyOf() { return _key; }
+
+TEST(StringFixed, Construct) {
+    constexpr basic_fixed_string s1 = "this is a large string, larger than any small buffer";
+
+    static_assert(s1.size() == 52);
+    static_assert(s1[5] == 'i' && s1[52] == '\0' && s1[100] == '\0');
+    ASSERT_EQ(string_view(s1), string_view("this is a large string, larger than any small buffer"));
+    ASSERT_EQ(s1.c_str()[s1.size()], '\0');
+}
+
+TEST(StringFixed, Concatenate) {
+    constexpr auto path = "usr"_fs + "/" + "local"_fs + "/" + "bin"_fs;
+
+    static_assert(std::is_same_v<decltype(path), const fixed_string<13>>);
+    static_assert(path == "usr/local/bin"_fs);
+    static_assert("a"_fs < "b"_fs && "ab"_fs > "a"_fs);
+    ASSERT_EQ(string_view(path), string_view("usr/local/bin"));
+}
+
+TEST(StringFixed, TemplateParameter) {
+    static_assert(KeyOf<"header">() == string_view("header"));
+    static_assert(KeyOf<"x-" + "forwarded"_fs>() == string_view("x-forwarded"));
+    ASSERT_EQ(KeyOf<"header">().data(), KeyOf<"header">().data());
+}
+
+TEST(StringFixed, Literal) {
+    constexpr auto v1 = "a view into static storage"_sv;
+    constexpr auto v2 = u8"utf-8"_sv;
+
+    static_assert(std::is_same_v<decltype(v1), const string_view>);
+    static_assert(std::is_same_v<decltype(v2), const u8string_view>);
+    static_assert(v1.size() == 26 && v2.size() == 5);
+    // Every use of the same literal shares its storage.
+    ASSERT_EQ("shared"_sv.data(), "shared"_sv.data());
+}
+
+TEST(StringFixed, ToString) {
+    {
+        constexpr auto key = "this is a "_fs + "large string";
+        string s1(key.view());
+
+        AssertLarge(s1, Large1);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
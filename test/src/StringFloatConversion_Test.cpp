@@ -0,0 +1,73 @@
+#include "common.hpp"
+#include "string_charconv.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+
+TEST(StringFloatConversion, Parse) {
+    auto result = parse<double>(string_view("3.25,next"));
+    ASSERT_TRUE(result);
+    ASSERT_EQ(result.value, 3.25);
+    ASSERT_EQ(result.length, 4ul);
+
+    ASSERT_EQ(parse<double>(string_view("-1e-3")).value, -0.001);
+    ASSERT_EQ(parse<double>(string_view("1e")).length, 1ul);
+    ASSERT_EQ(parse<float>(string_view("0.1")).value, 0.1f);
+    ASSERT_EQ(parse<double>(string_view("2.2250738585072014e-308")).value, std::numeric_limits<double>::min());
+    ASSERT_EQ(parse<double>(string_view("inf")).value, std::numeric_limits<double>::infinity());
+    ASSERT_TRUE(std::isnan(parse<double>(string_view("nan")).value));
+    ASSERT_FALSE(parse<double>(string_view("")));
+    ASSERT_FALSE(parse<double>(string_view("+1")));
+    ASSERT_FALSE(parse<double>(string_view("x1")));
+    ASSERT_FALSE(parse<double>(string_view("1e400")));
+}
+
+TEST(StringFloatConversion, Parse_OtherCharTypes) {
+    {
+        // Plain numbers take the fast path, the rest are narrowed.
+        ASSERT_EQ(parse<double>(u16string_view(u"-12.5;")).value, -12.5);
+        ASSERT_EQ(parse<double>(u16string_view(u"-12.5;")).length, 5ul);
+        ASSERT_EQ(parse<double>(u32string_view(U"123456789e-5")).value, 1234.56789);
+        ASSERT_EQ(parse<double>(u8string_view(u8"9007199254740993")).value, 9007199254740992.0);
+        ASSERT_EQ(parse<double>(u16string_view(u"1.7976931348623157e308")).value, std::numeric_limits<double>::max());
+        ASSERT_EQ(parse<float>(u16string_view(u"1e-45")).value, std::numeric_limits<float>::denorm_min());
+        ASSERT_EQ(parse<double>(u16string_view(u"-Infinity")).value, -std::numeric_limits<double>::infinity());
+        ASSERT_EQ(parse<double>(u16string_view(u"1e")).length, 1ul);
+        ASSERT_EQ(parse<double>(u32string_view(U"0.000000000000000000000000000000000000000000000000000000000000000000000000001")).value, 1e-75);
+        ASSERT_EQ(parse<double>(u16string(u"2.5e2°")).value, 250.0);
+        ASSERT_FALSE(parse<double>(u16string_view(u"e5")));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringFloatConversion, ToString) {
+    {
+        AssertSmall(to_string(0.1), "0.1");
+        AssertSmall(to_string(-0.0), "-0");
+        AssertSmall(to_string(1e100), "1e+100");
+        AssertSmall(to_string(0.1f), "0.1");
+        AssertSmall(to_string(123456.0), "123456");
+        AssertLarge(to_string(std::numeric_limits<double>::min()), "2.2250738585072014e-308");
+        ASSERT_EQ(u16string_view(to_string<u16string>(-2.5)), u16string_view(u"-2.5"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringFloatConversion, RoundTrip) {
+    {
+        std::mt19937_64 random(12345);
+        string s1;
+        for (int i = 0; i < 1000; ++i)
+        {
+            double value = std::bit_cast<double>(random());
+            if (!std::isfinite(value))
+                continue;
+            s1.clear();
+            append_float(s1, value);
+
+            ASSERT_EQ(parse<double>(s1).value, value);
+            ASSERT_EQ(parse<double>(to_string<u16string>(value)).value, value);
+        }
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
@@ -0,0 +1,69 @@
+#include "common.hpp"
+#include "string_format.hpp"
+
+#include <algorithm>
+
+static_assert(std::output_iterator<basic_string_appender<string>, const char&>);
+
+TEST(StringFormat, Appender) {
+    {
+        string s1("a");
+
+        std::ranges::copy(Large1, basic_string_appender(s1));
+
+        AssertLarge(s1, "athis is a large string");
+        ASSERT_EQ(s1.capacity(), 30ul);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+#if __cpp_lib_format
+
+static_assert(requires (string s) { format_into(s, "{}", s); });
+static_assert(!requires (u8string s) { format_into(s, u8"{}"); });
+static_assert(!requires { format_string<u16string>(u"{}"); });
+
+TEST(StringFormat, Formatter) {
+    {
+        string s1(Small1);
+
+        ASSERT_EQ(std::format("[{}]", Large1), "[this is a large string]");
+        ASSERT_EQ(std::format("[{:>8}]", s1), "[   small]");
+        ASSERT_EQ(std::format("[{:*^9.3}]", s1), "[***sma***]");
+        ASSERT_EQ(std::format(L"[{}]", wstring_view(L"wide")), L"[wide]");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringFormat, FormatInto_Small) {
+    {
+        string s1("x=");
+
+        format_into(s1, "{} y={:.2f}", 42, 1.5);
+
+        AssertSmall(s1, "x=42 y=1.50");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringFormat, FormatInto_Large) {
+    {
+        string s1("x=");
+
+        format_into(s1, "{} and {}", Large1, string(Large2));
+
+        AssertLarge(s1, "x=this is a large string and another string of largeness");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringFormat, FormatString) {
+    {
+        AssertSmall(format_string("{}-{:04}", 1, 2), "1-0002");
+        AssertLarge(format_string("{:>30}", Small1), "                         small");
+        ASSERT_EQ(wstring_view(format_string<wstring>(L"{}!", 5)), wstring_view(L"5!"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+#endif
@@ -0,0 +1,141 @@
+#include "common.hpp"
+#include <string>
+
+TEST(StringInsertErase, Insert) {
+    {
+        string s1("sall");
+        s1.insert(1, "m");
+
+        AssertSmall(s1, Small1);
+    }
+    {
+        string s1("small");
+        s1.insert(5, " and then some");
+
+        AssertLarge(s1, "small and then some");
+    }
+    {
+        string s1("this is a string");
+        s1.insert(10, "large ");
+
+        AssertLarge(s1, Large1);
+    }
+    {
+        string s1(Large1);
+        // Clamped to the end of the string.
+        s1.insert(100, 3, '!');
+        s1.insert(0, 2, '>');
+
+        AssertLarge(s1, ">>this is a large string!!!");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringInsertErase, Insert_SpareCapacity) {
+    {
+        string s1(Large1);
+        s1.reserve(64);
+        const char* data = s1.data();
+        s1.insert(0, "and ");
+        s1.insert(0, string_view(s1).substr(4, 5));
+
+        AssertLarge(s1, "this and this is a large string");
+        ASSERT_EQ(s1.data(), data);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringInsertErase, Erase) {
+    {
+        string s1("smalls");
+        s1.erase(5);
+
+        AssertSmall(s1, Small1);
+    }
+    {
+        string s1(Large1);
+        const char* data = s1.data();
+        s1.erase(8, 8);
+
+        AssertLarge(s1, "this is string");
+        ASSERT_EQ(s1.data(), data);
+    }
+    {
+        string s1(Large1);
+        // Clamped to the string.
+        s1.erase(100, 1);
+        s1.erase(4, 100);
+
+        AssertLarge(s1, "this");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringInsertErase, Erase_ShrinkToSmall) {
+    {
+        string s1(Large1);
+        s1.erase(8, 8, erase_policy::shrink_to_small);
+
+        AssertSmall(s1, "this is string");
+    }
+    {
+        string s1(Large2);
+        // Still too large for the small buffer.
+        s1.erase(0, 8, erase_policy::shrink_to_small);
+
+        AssertLarge(s1, "string of largeness");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringInsertErase, EraseIf) {
+    {
+        string s1("this\x01 is\t a\x7F large\x1B string");
+
+        ASSERT_EQ(s1.erase_if([](char c) { return c < 0x20 || c == 0x7F; }), 4u);
+        AssertLarge(s1, Large1);
+    }
+    {
+        string s1("this is a large string");
+
+        ASSERT_EQ(s1.erase_if([](char c) { return c == ' ' || c == 'i'; }, erase_policy::shrink_to_small), 7u);
+        AssertSmall(s1, "thssalargestrng");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringInsertErase, EraseAny) {
+    {
+        std::string expected;
+        std::string input;
+        for (int i = 0; i < 40; ++i)
+        {
+            input += "field" + std::to_string(i) + (i % 3 == 0 ? "\r\n" : "\t");
+            expected += "field" + std::to_string(i);
+        }
+        string s1(input.c_str());
+
+        ASSERT_EQ(s1.erase_any("\r\n\t"), input.size() - expected.size());
+        AssertLarge(s1, expected.c_str());
+    }
+    {
+        string s1("a-b-c");
+
+        ASSERT_EQ(s1.erase_any("xyz"), 0u);
+        ASSERT_EQ(s1.erase_any(string_view(s1).substr(1, 1)), 2u);
+        AssertSmall(s1, "abc");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringInsertErase, Constexpr) {
+    static_assert([]
+    {
+        string s1("ac");
+        s1.insert(1, "b");
+        s1.insert(0, 2, '-');
+        s1.erase(0, 1);
+        s1.erase_if([](char c) { return c == 'c'; });
+        return s1 == string_view("-ab");
+    }());
+}
@@ -0,0 +1,96 @@
+#include "common.hpp"
+#include "string_charconv.hpp"
+#include <limits>
+
+TEST(StringIntegerConversion, ToString) {
+    {
+        AssertSmall(to_string(0), "0");
+        AssertSmall(to_string(7u), "7");
+        AssertSmall(to_string(-42), "-42");
+        AssertSmall(to_string(std::int8_t(-128)), "-128");
+        AssertLarge(to_string(std::numeric_limits<std::int64_t>::max()), "9223372036854775807");
+        AssertLarge(to_string(std::numeric_limits<std::int64_t>::min()), "-9223372036854775808");
+        AssertLarge(to_string(std::numeric_limits<std::uint64_t>::max()), "18446744073709551615");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringIntegerConversion, ToString_EveryLength) {
+    std::uint64_t value = 0;
+    for (int length = 1; length <= 20; ++length)
+    {
+        value = value * 10 + length % 10;
+        std::string expected = std::to_string(value);
+
+        ASSERT_EQ(string_view(to_string(value)), string_view(expected.c_str()));
+        ASSERT_EQ(string_view(to_string(value - 1)), string_view(std::to_string(value - 1).c_str()));
+    }
+}
+
+TEST(StringIntegerConversion, ToString_OtherCharTypes) {
+    {
+        ASSERT_EQ(u16string_view(to_string<u16string>(-1234567)), u16string_view(u"-1234567"));
+        ASSERT_EQ(u32string_view(to_string<u32string>(99u)), u32string_view(U"99"));
+        ASSERT_EQ(small_string_view(to_string<small_string>(1000000)), small_string_view("1000000"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringIntegerConversion, AppendInteger) {
+    {
+        string s1("requests_total ");
+
+        append_integer(s1, 123456789);
+
+        AssertLarge(s1, "requests_total 123456789");
+
+        for (int i = 0; i < 100; ++i)
+            append_integer(s1, i);
+
+        ASSERT_TRUE(s1.ends_with(string_view("9899")));
+        ASSERT_EQ(s1.size(), 24ul + 190ul);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringIntegerConversion, Parse) {
+    auto result = parse<int>(string_view("-1234 rest"));
+    ASSERT_TRUE(result);
+    ASSERT_EQ(result.value, -1234);
+    ASSERT_EQ(result.length, 5ul);
+
+    ASSERT_EQ(parse<std::uint64_t>(string_view("18446744073709551615")).value, std::numeric_limits<std::uint64_t>::max());
+    ASSERT_EQ(parse<std::int64_t>(string_view("-9223372036854775808")).value, std::numeric_limits<std::int64_t>::min());
+    ASSERT_EQ(parse<std::uint32_t>(string_view("00000000000000000000000000042")).value, 42u);
+    ASSERT_EQ(parse<std::uint64_t>(string_view("1234567812345678x")).length, 16ul);
+    ASSERT_EQ(parse<int>(string_view("ff"), 16).value, 255);
+    ASSERT_EQ(parse<int>(string_view("-Zz"), 36).value, -1295);
+    ASSERT_EQ(parse<int>(string_view("102"), 2).length, 2ul);
+}
+
+TEST(StringIntegerConversion, Parse_Failures) {
+    ASSERT_FALSE(parse<int>(string_view("")));
+    ASSERT_FALSE(parse<int>(string_view("-")));
+    ASSERT_FALSE(parse<int>(string_view("+1")));
+    ASSERT_FALSE(parse<unsigned>(string_view("-1")));
+    ASSERT_FALSE(parse<std::int8_t>(string_view("128")));
+    ASSERT_TRUE(parse<std::int8_t>(string_view("-128")));
+    ASSERT_FALSE(parse<std::int8_t>(string_view("-129")));
+    ASSERT_FALSE(parse<std::uint64_t>(string_view("18446744073709551616")));
+    ASSERT_FALSE(parse<std::uint64_t>(string_view("99999999999999999999999999")));
+}
+
+TEST(StringIntegerConversion, Parse_OtherCharTypes) {
+    {
+        ASSERT_EQ(parse<int>(u16string_view(u"-31337")).value, -31337);
+        ASSERT_EQ(parse<long>(u32string_view(U"123456789012")).value, 123456789012l);
+        ASSERT_EQ(parse<int>(u8string(u8"77 bottles")).length, 2ul);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringIntegerConversion, Constexpr) {
+    static_assert(parse<int>(string_view("-12345678901")).length == 0);
+    static_assert(parse<long>(string_view("12345678901")).value == 12345678901);
+    static_assert(string_view(to_string(-1234567)) == string_view("-1234567"));
+}
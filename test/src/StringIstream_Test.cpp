@@ -0,0 +1,104 @@
+#include "common.hpp"
+#include "string_istream.hpp"
+#include <sstream>
+
+TEST(StringIstream, Getline) {
+    {
+        std::istringstream stream("small\nthis is a large string\n\nlast");
+        string s1;
+
+        ASSERT_TRUE(getline(stream, s1));
+        AssertSmall(s1, "small");
+        ASSERT_TRUE(getline(stream, s1));
+        AssertLarge(s1, "this is a large string");
+        const char* allocation = s1.data();
+        ASSERT_TRUE(getline(stream, s1));
+        AssertEmptyLarge(s1, "");
+        ASSERT_EQ(s1.data(), allocation);
+        ASSERT_TRUE(getline(stream, s1));
+        ASSERT_EQ(string_view(s1), string_view("last"));
+        ASSERT_TRUE(stream.eof());
+        ASSERT_FALSE(getline(stream, s1));
+        ASSERT_TRUE(s1.empty());
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringIstream, Getline_LongLine) {
+    {
+        std::string line(1000, 'x');
+        for (std::size_t i = 0; i < line.size(); ++i)
+            line[i] = static_cast<char>('a' + i % 26);
+        std::istringstream stream(line + "|" + line);
+        string s1;
+
+        ASSERT_TRUE(getline(stream, s1, '|'));
+        ASSERT_EQ(string_view(s1), string_view(line.c_str()));
+        ASSERT_FALSE(stream.eof());
+        ASSERT_TRUE(getline(stream, s1, '|'));
+        ASSERT_EQ(string_view(s1), string_view(line.c_str()));
+        ASSERT_TRUE(stream.eof());
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringIstream, Getline_DelimiterAtCapacity) {
+    {
+        // Exactly fills the small buffer before the delimiter.
+        std::string line(string::sboc, 'x');
+        std::istringstream stream(line + "\nnext");
+        string s1;
+
+        ASSERT_TRUE(getline(stream, s1));
+        AssertSmall(s1, string_view(line.c_str()));
+        ASSERT_TRUE(getline(stream, s1));
+        ASSERT_EQ(string_view(s1), string_view("next"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringIstream, Getline_Wide) {
+    {
+        std::wistringstream stream(L"one\ntwo");
+        wstring s1;
+
+        ASSERT_TRUE(getline(stream, s1));
+        ASSERT_EQ(wstring_view(s1), wstring_view(L"one"));
+        ASSERT_TRUE(getline(stream, s1));
+        ASSERT_EQ(wstring_view(s1), wstring_view(L"two"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringIstream, Extraction) {
+    {
+        std::istringstream stream("  small\tthis_is_a_large_string \n word");
+        string s1;
+
+        ASSERT_TRUE(stream >> s1);
+        AssertSmall(s1, "small");
+        ASSERT_TRUE(stream >> s1);
+        AssertLarge(s1, "this_is_a_large_string");
+        ASSERT_TRUE(stream >> s1);
+        ASSERT_EQ(string_view(s1), string_view("word"));
+        ASSERT_TRUE(stream.eof());
+        ASSERT_FALSE(stream >> s1);
+        ASSERT_TRUE(s1.empty());
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringIstream, Extraction_Width) {
+    {
+        std::istringstream stream("abcdefgh");
+        string s1, s2;
+
+        stream.width(3);
+        stream >> s1 >> s2;
+
+        AssertSmall(s1, "abc");
+        AssertSmall(s2, "defgh");
+        ASSERT_EQ(stream.width(), 0);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
@@ -0,0 +1,57 @@
+#include "common.hpp"
+#include "string_keyword_matcher.hpp"
+#include <string>
+
+// IMAP, SMTP and HTTP tokens, with many of the same length and long shared prefixes.
+static constexpr string_view Tokens[]
+{
+    "GET", "PUT", "POST", "HEAD", "PATCH", "TRACE", "DELETE", "OPTIONS", "CONNECT",
+    "HELO", "EHLO", "MAIL", "RCPT", "DATA", "RSET", "VRFY", "EXPN", "HELP", "NOOP", "QUIT",
+    "LOGIN", "LOGOUT", "SELECT", "EXAMINE", "CREATE", "RENAME", "SUBSCRIBE", "UNSUBSCRIBE",
+    "LIST", "LSUB", "STATUS", "APPEND", "CHECK", "CLOSE", "EXPUNGE", "SEARCH", "FETCH", "STORE",
+    "CAPABILITY", "AUTHENTICATE",
+    "Content-Length", "Content-Type", "Content-Encoding", "Content-Language", "Content-Location",
+};
+
+TEST(StringKeywordMatcher, Match) {
+    constexpr auto matcher = make_keyword_matcher(Tokens);
+
+    static_assert(matcher.size() == 45);
+    for (std::size_t i = 0; i < matcher.size(); ++i)
+    {
+        ASSERT_EQ(matcher.match(Tokens[i]), i);
+        // Not the same pointer as the keyword.
+        std::string copy(Tokens[i].data(), Tokens[i].size());
+        ASSERT_EQ(matcher(string_view(copy.data(), copy.size())), i);
+    }
+}
+
+TEST(StringKeywordMatcher, NoMatch) {
+    constexpr auto matcher = make_keyword_matcher(Tokens);
+
+    ASSERT_EQ(matcher(""), matcher.npos);
+    ASSERT_EQ(matcher("get"), matcher.npos);
+    ASSERT_EQ(matcher("GOT"), matcher.npos);
+    ASSERT_EQ(matcher("GETS"), matcher.npos);
+    ASSERT_EQ(matcher("POS"), matcher.npos);
+    // The same length as, and sharing the first word with, other keywords.
+    ASSERT_EQ(matcher("Content-Lengths"), matcher.npos);
+    ASSERT_EQ(matcher("Content-Locution"), matcher.npos);
+    ASSERT_EQ(matcher(string_view("GET\0", 4)), matcher.npos);
+}
+
+TEST(StringKeywordMatcher, Constexpr) {
+    constexpr auto matcher = make_keyword_matcher({ "yes", "no", "maybe" });
+
+    static_assert(matcher("yes") == 0 && matcher("no") == 1 && matcher("maybe") == 2);
+    static_assert(matcher("nope") == matcher.npos && matcher[2] == string_view("maybe"));
+    static_assert(make_keyword_matcher(Tokens)("Content-Language") == 43);
+}
+
+TEST(StringKeywordMatcher, WideCharacters) {
+    constexpr auto matcher = make_keyword_matcher<char16_t>({ u"alpha", u"alpine", u"alps", u"alpaca" });
+
+    static_assert(matcher(u"alpine") == 1 && matcher(u"alpaca") == 3);
+    ASSERT_EQ(matcher(u"alps"), 2u);
+    ASSERT_EQ(matcher(u"alpina"), matcher.npos);
+}
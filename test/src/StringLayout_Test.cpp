@@ -0,0 +1,28 @@
+#include "common.hpp"
+
+TEST(StringLayout, Default) {
+    constexpr auto layout = string::layout_info();
+
+    static_assert(layout.size == sizeof(string) && layout.alignment == alignof(string));
+    static_assert(layout.sboc == string::sboc && layout.buffer_size == string::sboc + 1);
+    static_assert(layout.buffer_offset == 0 && layout.size_offset == 16 && layout.capacity_offset == 24);
+    static_assert(layout.padding == 0 && layout.per_cache_line() == 2);
+}
+
+TEST(StringLayout, ReclaimedPadding) {
+    constexpr auto layout = small_string::layout_info();
+
+    // The size and capacity sit in what would be the padding after the pointer.
+    static_assert(layout.size == 24 && layout.sboc == 21 && layout.max_length == 126);
+    static_assert(layout.size_offset == 22 && layout.capacity_offset == 23 && layout.field_size == 1);
+    static_assert(layout.padding == 0);
+}
+
+TEST(StringLayout, MinInternalCapacity) {
+    constexpr auto layout = basic_string<char, std::size_t, 20>::layout_info();
+
+    // The small buffer grows a pointer at a time.
+    static_assert(layout.sboc == 23 && layout.size == 40 && layout.size_offset == 24);
+    static_assert(layout.per_cache_line() == 1 && layout.per_cache_line(128) == 3);
+    static_assert(u32string::layout_info().sboc == 3 && u32string::layout_info().buffer_size == 16);
+}
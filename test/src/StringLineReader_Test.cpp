@@ -0,0 +1,111 @@
+#include "common.hpp"
+#include "string_line_reader.hpp"
+#include <sstream>
+#include <vector>
+
+static const std::string Text = "short\r\na line that is longer than one block\n\nx\nthe last line has no line ending";
+static const std::vector<std::string> Lines = { "short", "a line that is longer than one block", "", "x", "the last line has no line ending" };
+
+static std::vector<std::string> ReadAll(line_reader& reader)
+{
+    std::vector<std::string> lines;
+    string_view line;
+    while (reader.next(line))
+        lines.emplace_back(line.data(), line.size());
+    return lines;
+}
+
+TEST(StringLineReader, Stream_EveryBlockSize) {
+    {
+        for (std::size_t block_size = 1; block_size <= Text.size() + 1; ++block_size)
+        {
+            std::istringstream stream(Text);
+            line_reader reader(stream, block_size);
+
+            ASSERT_EQ(ReadAll(reader), Lines);
+        }
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringLineReader, Stream_NoCopyWithinBlock) {
+    {
+        std::istringstream stream("first\nsecond\n");
+        line_reader reader(stream);
+        string_view first, second;
+
+        ASSERT_TRUE(reader.next(first));
+        ASSERT_TRUE(reader.next(second));
+        ASSERT_EQ(first.data() + 6, second.data());
+        ASSERT_FALSE(reader.next(second));
+        ASSERT_EQ(second, string_view("second"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringLineReader, Stream_NarrowSize) {
+    {
+        std::string text;
+        for (int i = 0; i < 100; ++i)
+            text += "line " + std::to_string(i) + '\n';
+        std::istringstream stream(text);
+        basic_line_reader<char, std::uint8_t> reader(stream);
+        basic_string_view<char, std::uint8_t> line;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            ASSERT_TRUE(reader.next(line));
+            ASSERT_EQ(std::string(line.data(), line.size()), "line " + std::to_string(i));
+        }
+        ASSERT_FALSE(reader.next(line));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringLineReader, Stream_NarrowSize_LineTooLong) {
+    {
+        std::istringstream stream(std::string(100, 'a') + std::string(100, 'b') + std::string(20, 'c') + "\nnext\n");
+        basic_line_reader<char, std::uint8_t> reader(stream, 100);
+        basic_string_view<char, std::uint8_t> line;
+
+        ASSERT_TRUE(reader.next(line));
+        ASSERT_EQ(std::string(line.data(), line.size()), std::string(100, 'a') + std::string(26, 'b'));
+        ASSERT_EQ(reader.error(), EOVERFLOW);
+        ASSERT_TRUE(reader.next(line));
+        ASSERT_EQ(std::string(line.data(), line.size()), "next");
+        ASSERT_FALSE(reader.next(line));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringLineReader, Descriptor) {
+    {
+        int pipe_descriptors[2];
+        ASSERT_EQ(::pipe(pipe_descriptors), 0);
+        ASSERT_EQ(::write(pipe_descriptors[1], Text.data(), Text.size()), static_cast<ssize_t>(Text.size()));
+        ::close(pipe_descriptors[1]);
+
+        line_reader reader(pipe_descriptors[0], 16);
+
+        ASSERT_EQ(ReadAll(reader), Lines);
+        ASSERT_EQ(reader.error(), 0);
+        ::close(pipe_descriptors[0]);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringLineReader, Descriptor_Invalid) {
+    line_reader reader(-1);
+    string_view line;
+
+    ASSERT_FALSE(reader.next(line));
+    ASSERT_EQ(reader.error(), EBADF);
+}
+
+TEST(StringLineReader, Empty) {
+    std::istringstream stream("");
+    line_reader reader(stream);
+    string_view line;
+
+    ASSERT_FALSE(reader.next(line));
+}
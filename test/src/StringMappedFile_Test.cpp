@@ -0,0 +1,95 @@
+#include "common.hpp"
+#include "string_mapped_file.hpp"
+#include <cstdio>
+#include <vector>
+
+// Writes a temporary file that is removed when this goes out of scope.
+struct TemporaryFile
+{
+    explicit TemporaryFile(string_view contents)
+    {
+        std::FILE* file = std::fopen(Path, "wb");
+        std::fwrite(contents.data(), 1, contents.size(), file);
+        std::fclose(file);
+    }
+
+    ~TemporaryFile() { std::remove(Path); }
+
+    static constexpr const char* Path = "StringMappedFile_Test.tmp";
+};
+
+TEST(StringMappedFile, View) {
+    {
+        TemporaryFile temporary("first line\r\nsecond line\n\nfourth line");
+        mapped_file file(TemporaryFile::Path);
+
+        ASSERT_TRUE(file.is_open());
+        ASSERT_EQ(file.size(), 36ul);
+        ASSERT_EQ(file.view(), string_view("first line\r\nsecond line\n\nfourth line"));
+        ASSERT_EQ(file.view<char8_t>(), u8string_view(u8"first line\r\nsecond line\n\nfourth line"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringMappedFile, Lines) {
+    {
+        TemporaryFile temporary("first line\r\nsecond line\n\nfourth line\n");
+        mapped_file file(TemporaryFile::Path, { .sequential = true, .will_need = true, .huge_pages = true });
+
+        std::vector<string_view> lines;
+        for (string_view line : file.lines())
+            lines.push_back(line);
+
+        ASSERT_EQ(lines, (std::vector<string_view>{ "first line", "second line", "", "fourth line" }));
+        ASSERT_EQ((*file.lines().begin()).data(), file.data());
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringMappedFile, View_TooLarge) {
+    {
+        std::string contents(300, 'x');
+        TemporaryFile temporary(string_view(contents.data(), contents.size()));
+        mapped_file file(TemporaryFile::Path);
+
+        ASSERT_EQ(file.size(), 300ul);
+        ASSERT_TRUE((file.view<char, std::uint8_t>().empty()));
+        ASSERT_TRUE((file.lines<char, std::uint8_t>().begin() == file.lines<char, std::uint8_t>().end()));
+        ASSERT_EQ((file.view<char, std::uint16_t>().size()), 300u);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringMappedFile, Empty) {
+    TemporaryFile temporary("");
+    mapped_file file(TemporaryFile::Path);
+
+    ASSERT_TRUE(file);
+    ASSERT_TRUE(file.empty());
+    ASSERT_TRUE(file.view().empty());
+    ASSERT_TRUE(file.lines().empty());
+}
+
+TEST(StringMappedFile, Missing) {
+    mapped_file file("this file does not exist");
+
+    ASSERT_FALSE(file);
+    ASSERT_EQ(file.error(), ENOENT);
+    ASSERT_EQ(file.data(), nullptr);
+}
+
+TEST(StringMappedFile, Move) {
+    TemporaryFile temporary("contents");
+    mapped_file file1(TemporaryFile::Path);
+    const char* data = file1.data();
+
+    mapped_file file2(std::move(file1));
+
+    ASSERT_FALSE(file1);
+    ASSERT_EQ(file2.data(), data);
+
+    file1 = std::move(file2);
+
+    ASSERT_EQ(file1.view(), string_view("contents"));
+    ASSERT_FALSE(file2.is_open());
+}
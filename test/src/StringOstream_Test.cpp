@@ -0,0 +1,49 @@
+#include "common.hpp"
+#include "string_ostream.hpp"
+#include "string_traits.hpp"
+#include <iomanip>
+#include <sstream>
+
+TEST(StringOstream, Insertion) {
+    {
+        std::ostringstream stream;
+        string s1(Large1);
+
+        stream << Small1 << ' ' << s1;
+
+        ASSERT_EQ(stream.str(), "small this is a large string");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringOstream, Insertion_Padded) {
+    {
+        std::ostringstream stream;
+        string s1(Small1);
+
+        stream << '[' << std::setw(8) << s1 << "][" << std::left << std::setfill('*') << std::setw(7) << Small1 << ']' << Small1;
+
+        ASSERT_EQ(stream.str(), "[   small][small**]small");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringOstream, Insertion_OtherTraits) {
+    {
+        std::ostringstream stream;
+
+        stream << ci_string("Content-Length") << ci_string_view(": 0");
+
+        ASSERT_EQ(stream.str(), "Content-Length: 0");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringOstream, Insertion_Failed) {
+    std::ostringstream stream;
+    stream.setstate(std::ios_base::failbit);
+
+    stream << Small1;
+
+    ASSERT_EQ(stream.str(), "");
+}
@@ -0,0 +1,159 @@
+#include "common.hpp"
+#include <utility>
+
+static constexpr string_view Full = "twenty-three characters";
+static constexpr string_view Over = "twenty-four characters!!";
+
+static void AssertPacked(const packed_string& s, string_view expected, bool small) {
+    ASSERT_EQ(s.small(), small);
+    ASSERT_EQ(s.size(), expected.size());
+    ASSERT_EQ(string_view(s), expected);
+    ASSERT_EQ(s.c_str()[s.size()], '\0');
+    if (small)
+        ASSERT_EQ(s.capacity(), packed_string::sboc);
+    else
+        ASSERT_GE(s.capacity(), s.size());
+}
+
+TEST(StringPacked, Layout) {
+    constexpr auto layout = packed_string::layout_info();
+
+    static_assert(sizeof(packed_string) == 24 && packed_string::sboc == 23);
+    static_assert(layout.layout == string_layout::packed && layout.per_cache_line() == 2);
+    static_assert(layout.size_offset == 8 && layout.capacity_offset == 16 && layout.padding == 0);
+    static_assert(packed_u16string::sboc == 11 && packed_u32string::sboc == 5);
+    static_assert(sizeof(basic_packed_string<char, std::uint32_t>) == 16 && basic_packed_string<char, std::uint32_t>::sboc == 15);
+    ASSERT_EQ(Full.size(), 23u);
+}
+
+TEST(StringPacked, Construct) {
+    {
+        packed_string s1;
+        packed_string s2(Full);
+        packed_string s3(Over);
+
+        AssertPacked(s1, Empty, true);
+        // The unused count is the null terminator once the small buffer is full.
+        AssertPacked(s2, Full, true);
+        AssertPacked(s3, Over, false);
+        ASSERT_EQ(s2.data(), reinterpret_cast<const char*>(&s2));
+    }
+    {
+        packed_string s1(23, 'x');
+        packed_string s2(100, 'y');
+
+        AssertPacked(s1, string_view(std::string(23, 'x').c_str()), true);
+        AssertPacked(s2, string_view(std::string(100, 'y').c_str()), false);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringPacked, CopyAndMove) {
+    {
+        packed_string s1(Full);
+        packed_string s2(Over);
+        packed_string s3(s1);
+        packed_string s4(s2);
+
+        AssertPacked(s3, Full, true);
+        AssertPacked(s4, Over, false);
+
+        packed_string s5(std::move(s3));
+        packed_string s6(std::move(s4));
+
+        AssertPacked(s3, Empty, true);
+        AssertPacked(s4, Empty, true);
+        AssertPacked(s5, Full, true);
+        AssertPacked(s6, Over, false);
+
+        s5 = s6;
+        AssertPacked(s5, Over, false);
+        s1 = std::move(s5);
+        AssertPacked(s1, Over, false);
+        // s1 was small, so it took the allocation.
+        AssertPacked(s5, Empty, true);
+        s2 = Small1;
+        AssertPacked(s2, Small1, false);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringPacked, GrowAndShrink) {
+    {
+        packed_string s1(Small1);
+        s1.insert(5, " but growing");
+        AssertPacked(s1, "small but growing", true);
+        s1.replace(0, 5, "almost full");
+        AssertPacked(s1, "almost full but growing", true);
+        s1.insert(0, 1, '>');
+        AssertPacked(s1, ">almost full but growing", false);
+
+        s1.erase(1, 7, erase_policy::shrink_to_small);
+        AssertPacked(s1, ">full but growing", true);
+        s1.reserve(40);
+        AssertPacked(s1, ">full but growing", false);
+        s1.shrink_to_fit();
+        AssertPacked(s1, ">full but growing", true);
+    }
+    {
+        packed_string s1("a-b-c-d-e-f-g-h");
+        ASSERT_EQ(s1.replace_all("-", "--"), 7u);
+        AssertPacked(s1, "a--b--c--d--e--f--g--h", true);
+        s1.trim("a");
+        AssertPacked(s1, "--b--c--d--e--f--g--h", true);
+        ASSERT_EQ(s1.erase_any("-"), 14u);
+        AssertPacked(s1, "bcdefgh", true);
+        s1.clear();
+        AssertPacked(s1, Empty, true);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringPacked, Swap) {
+    {
+        packed_string s1(Full);
+        packed_string s2(Small1);
+        packed_string s3(Over);
+
+        s1.swap(s2);
+        AssertPacked(s1, Small1, true);
+        AssertPacked(s2, Full, true);
+        s1.swap(s3);
+        AssertPacked(s1, Over, false);
+        AssertPacked(s3, Small1, true);
+        s3.swap(s1);
+        AssertPacked(s1, Small1, true);
+        AssertPacked(s3, Over, false);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringPacked, WideCharacters) {
+    {
+        packed_u32string s1(U"fives");
+        packed_u32string s2(U"sixsix");
+
+        ASSERT_TRUE(s1.small());
+        ASSERT_FALSE(s2.small());
+        s2.erase(5, 1, erase_policy::shrink_to_small);
+        ASSERT_TRUE(s2.small());
+        ASSERT_EQ(s2, u32string_view(U"sixsi"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringPacked, Constexpr) {
+    using constexpr_string = basic_string<char, std::size_t, 15, std::char_traits<char>, std::allocator<char>, string_layout::packed>;
+
+    // Packed strings are never small when constant evaluated, but behave the same.
+    static_assert([]
+    {
+        constexpr_string s1("ac");
+        s1.insert(1, "b");
+        constexpr_string s2(std::move(s1));
+        s1 = s2;
+        s1.erase(0, 1, erase_policy::shrink_to_small);
+        s1.swap(s2);
+        return s1 == string_view("abc") && s2 == string_view("bc") && s2.capacity() == constexpr_string::sboc && !s2.small();
+    }());
+}
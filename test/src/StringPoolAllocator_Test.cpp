@@ -0,0 +1,94 @@
+#include "common.hpp"
+#include "string_pool_allocator.hpp"
+#include <thread>
+#include <vector>
+
+template <typename _size_t, string_layout _layout = string_layout::standard>
+using pool_string = basic_string<char, _size_t, 15, std::char_traits<char>, pool_allocator<char>, _layout>;
+
+TEST(StringPoolAllocator, SizeClasses) {
+    using classes = _pool_size_classes<4>;
+
+    static_assert(classes::sizes[0] == 16 && classes::sizes[6] == 64 && classes::sizes[7] == 80 && classes::sizes.back() == 4096);
+    static_assert(classes::of(1) == 0 && classes::of(17) == 1 && classes::of(64) == 6 && classes::of(65) == 7);
+    static_assert(_pool_size_classes<1>::sizes[3] == 128 && _pool_size_classes<1>::of(129) == 4);
+
+    pool_allocator<char> allocator;
+    auto a = allocator.allocate_at_least(17);
+    auto b = allocator.allocate_at_least(100);
+    auto c = allocator.allocate_at_least(5000);
+    ASSERT_EQ(a.count, 24u);
+    ASSERT_EQ(b.count, 112u);
+    ASSERT_EQ(c.count, 5000u);
+    allocator.deallocate(a.ptr, 17);
+    allocator.deallocate(b.ptr, b.count);
+    allocator.deallocate(c.ptr, c.count);
+
+    pow2_pool_allocator<char16_t> wide;
+    auto d = wide.allocate_at_least(17);
+    ASSERT_EQ(d.count, 32u);
+    wide.deallocate(d.ptr, d.count);
+}
+
+TEST(StringPoolAllocator, Reuse) {
+    pool_allocator<char> allocator;
+    char* a = allocator.allocate(40);
+    allocator.deallocate(a, 40);
+    // The thread's cache hands back the block it was just given.
+    char* b = allocator.allocate(33);
+    ASSERT_EQ(a, b);
+    allocator.deallocate(b, 33);
+}
+
+TEST(StringPoolAllocator, CapacityFeedback) {
+    // The capacity fills the size class.
+    pool_string<std::size_t> s1("sixteen chars!!!");
+    ASSERT_EQ(s1.capacity(), 23u);
+    s1.insert(s1.size(), 7, '.');
+    ASSERT_EQ(s1.capacity(), 23u);
+    s1.insert(s1.size(), 1, '.');
+    ASSERT_EQ(s1.capacity(), 47u);
+
+    // Only as far as the size type can describe.
+    pool_string<std::uint8_t> s2(120, 'x');
+    ASSERT_EQ(s2.capacity(), s2.max_size());
+    // And as far as a spill string's byte holds, without a header.
+    pool_string<std::size_t, string_layout::spill> s3(250, 'y');
+    ASSERT_EQ(s3.capacity(), 254u);
+    pool_string<std::size_t, string_layout::spill> s4(300, 'z');
+    ASSERT_EQ(s4.capacity(), 320u - 16 - 1);
+    ASSERT_EQ(s4.size(), 300u);
+}
+
+TEST(StringPoolAllocator, Threads) {
+    constexpr std::size_t thread_count = 4;
+    constexpr std::size_t string_count = 4000;
+    std::vector<pool_string<std::size_t>> strings(string_count);
+
+    // Each thread builds every fourth string, then another thread frees them.
+    auto run = [&strings](auto work)
+    {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < thread_count; ++t)
+            threads.emplace_back(work, t);
+        for (std::thread& thread : threads)
+            thread.join();
+    };
+    run([&strings](std::size_t t)
+    {
+        for (std::size_t round = 0; round < 8; ++round)
+            for (std::size_t i = t; i < string_count; i += thread_count)
+                strings[i] = pool_string<std::size_t>(16 + (i + round) % 120, static_cast<char>('a' + t));
+    });
+    for (std::size_t i = 0; i < string_count; ++i)
+    {
+        ASSERT_EQ(strings[i].size(), 16 + (i + 7) % 120);
+        ASSERT_EQ(strings[i].front(), static_cast<char>('a' + i % thread_count));
+    }
+    run([&strings](std::size_t t)
+    {
+        for (std::size_t i = (t + 1) % thread_count; i < string_count; i += thread_count)
+            strings[i] = pool_string<std::size_t>();
+    });
+    ASSERT_TRUE(std::all_of(strings.begin(), strings.end(), [](const auto& s) { return s.empty(); }));
+}
@@ -0,0 +1,130 @@
+#include "common.hpp"
+
+TEST(StringReplace, Replace) {
+    {
+        string s1("small");
+        s1.replace(1, 3, "ho");
+
+        AssertSmall(s1, "shol");
+    }
+    {
+        string s1("small");
+        s1.replace(0, 5, Large1);
+
+        AssertLarge(s1, Large1);
+    }
+    {
+        string s1(Large1);
+        s1.replace(10, 5, "big");
+
+        AssertLarge(s1, "this is a big string");
+    }
+    {
+        string s1(Large1);
+        // Clamped to the end of the string.
+        s1.replace(100, 5, "!");
+        s1.replace(16, 100, "world");
+
+        AssertLarge(s1, "this is a large world");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringReplace, Replace_Self) {
+    {
+        string s1(Large1);
+        // The view is moved by the replacement, so it must be copied first.
+        s1.replace(0, 4, string_view(s1).substr(10, 12));
+
+        AssertLarge(s1, "large string is a large string");
+    }
+    {
+        string s1(Large1);
+        s1.reserve(64);
+        s1.replace(0, 0, s1);
+
+        AssertLarge(s1, "this is a large stringthis is a large string");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringReplace, ReplaceAll_Shrink) {
+    {
+        string s1("a--b--c----d");
+        const char* data = s1.data();
+
+        ASSERT_EQ(s1.replace_all("--", "-"), 4u);
+        AssertSmall(s1, "a-b-c--d");
+        ASSERT_EQ(s1.data(), data);
+    }
+    {
+        string s1("{x} and {x} and {x}");
+
+        ASSERT_EQ(s1.replace_all("{x}", "1"), 3u);
+        AssertLarge(s1, "1 and 1 and 1");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringReplace, ReplaceAll_Grow) {
+    {
+        string s1("Hello {name}, {name}!");
+
+        ASSERT_EQ(s1.replace_all("{name}", "everybody out there"), 2u);
+        AssertLarge(s1, "Hello everybody out there, everybody out there!");
+        // Grown exactly once.
+        ASSERT_EQ(s1.capacity(), s1.size());
+    }
+    {
+        string s1("a.b.c.d");
+        s1.reserve(100);
+        const char* data = s1.data();
+
+        ASSERT_EQ(s1.replace_all(".", "::"), 3u);
+        AssertLarge(s1, "a::b::c::d");
+        ASSERT_EQ(s1.data(), data);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringReplace, ReplaceAll_NoMatches) {
+    {
+        string s1(Large1);
+
+        ASSERT_EQ(s1.replace_all("xyz", "abc"), 0u);
+        ASSERT_EQ(s1.replace_all("", "abc"), 0u);
+        ASSERT_EQ(s1.replace_all("this is a large string, but longer", ""), 0u);
+        AssertLarge(s1, Large1);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringReplace, ReplaceAll_Self) {
+    {
+        string s1("ab ab ab");
+
+        ASSERT_EQ(s1.replace_all(string_view(s1).substr(0, 2), string_view(s1).substr(0, 5)), 3u);
+        AssertLarge(s1, "ab ab ab ab ab ab");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringReplace, ReplaceAll_OtherCharTypes) {
+    {
+        u16string s1(u"x + y + z");
+
+        ASSERT_EQ(s1.replace_all(u" + ", u"+"), 2u);
+        ASSERT_EQ(u16string_view(s1), u16string_view(u"x+y+z"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringReplace, Constexpr) {
+    static_assert([]
+    {
+        string s1("1, 2, 3");
+        s1.replace_all(", ", " and ");
+        s1.replace(0, 1, "one");
+        return s1 == string_view("one and 2 and 3");
+    }());
+}
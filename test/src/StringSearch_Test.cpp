@@ -0,0 +1,99 @@
+#include "common.hpp"
+
+static constexpr string_view Haystack = "one two three two one";
+
+TEST(StringSearch, Find) {
+    ASSERT_EQ(Haystack.find(string_view("two")), 4ul);
+    ASSERT_EQ(Haystack.find(string_view("two"), 5), 14ul);
+    ASSERT_EQ(Haystack.find(string_view("one"), 1), 18ul);
+    ASSERT_EQ(Haystack.find(string_view("four")), string_view::npos);
+    ASSERT_EQ(Haystack.find(string_view("one two three two one!")), string_view::npos);
+    ASSERT_EQ(Haystack.find(string_view(), 3), 3ul);
+    ASSERT_EQ(Haystack.find(string_view(), 100), string_view::npos);
+    ASSERT_EQ(Haystack.find('t'), 4ul);
+    ASSERT_EQ(Haystack.find('t', 5), 8ul);
+    ASSERT_EQ(Haystack.find('z'), string_view::npos);
+    ASSERT_EQ(Haystack.find('o', 100), string_view::npos);
+}
+
+TEST(StringSearch, RFind) {
+    ASSERT_EQ(Haystack.rfind(string_view("two")), 14ul);
+    ASSERT_EQ(Haystack.rfind(string_view("two"), 13), 4ul);
+    ASSERT_EQ(Haystack.rfind(string_view("one"), 0), 0ul);
+    ASSERT_EQ(Haystack.rfind(string_view("four")), string_view::npos);
+    ASSERT_EQ(Haystack.rfind(string_view()), Haystack.size());
+    ASSERT_EQ(Haystack.rfind('e'), 20ul);
+    ASSERT_EQ(Haystack.rfind('e', 19), 12ul);
+    ASSERT_EQ(Empty.rfind('e'), string_view::npos);
+}
+
+TEST(StringSearch, FindOf) {
+    ASSERT_EQ(Haystack.find_first_of(string_view("wxyz")), 5ul);
+    ASSERT_EQ(Haystack.find_first_of(string_view("")), string_view::npos);
+    ASSERT_EQ(Haystack.find_first_not_of(string_view("one ")), 4ul);
+    ASSERT_EQ(Haystack.find_first_not_of('o'), 1ul);
+    ASSERT_EQ(Haystack.find_last_of(string_view("wt")), 15ul);
+    ASSERT_EQ(Haystack.find_last_of(string_view("wt"), 13), 8ul);
+    ASSERT_EQ(Haystack.find_last_not_of(string_view("one ")), 15ul);
+    ASSERT_EQ(Haystack.find_last_not_of('e'), 19ul);
+    ASSERT_EQ(Empty.find_last_of(string_view("a")), string_view::npos);
+    ASSERT_EQ(string_view("aaa").find_first_not_of('a'), string_view::npos);
+}
+
+TEST(StringSearch, Contains) {
+    ASSERT_TRUE(Haystack.contains(string_view("three")));
+    ASSERT_FALSE(Haystack.contains(string_view("four")));
+    ASSERT_TRUE(Haystack.contains('h'));
+    ASSERT_FALSE(Haystack.contains('z'));
+}
+
+TEST(StringSearch, String) {
+    {
+        string s1(Haystack);
+
+        ASSERT_EQ(s1.find(string_view("three")), 8ul);
+        ASSERT_EQ(s1.rfind('o'), 18ul);
+        ASSERT_EQ(s1.find_first_of(string_view("h")), 9ul);
+        ASSERT_TRUE(s1.contains(string_view("two one")));
+        ASSERT_TRUE(s1.starts_with(string_view("one ")));
+        ASSERT_TRUE(s1.ends_with(string_view(" one")));
+        AssertSmall(s1.substr(4, 9), "two three");
+        AssertLarge(s1.substr(4), "two three two one");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringSearch, StringComparison) {
+    {
+        string s1(Large1);
+        string s2(Large2);
+        string s3(Large1);
+
+        ASSERT_TRUE(s1 == s3);
+        ASSERT_TRUE(s1 != s2);
+        ASSERT_TRUE(s2 < s1);
+        ASSERT_TRUE(s1 == Large1);
+        ASSERT_TRUE(Large2 == s2);
+        ASSERT_TRUE(Large2 < s1);
+        ASSERT_GT(s1.compare(Large2), 0);
+        ASSERT_EQ(s1.compare(0, 4, string_view("this")), 0);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringSearch, Hash) {
+    {
+        string s1(Large1);
+
+        ASSERT_EQ(std::hash<string>()(s1), std::hash<string_view>()(Large1));
+        ASSERT_EQ(std::hash<string_view>()(Large1), std::hash<std::string_view>()(std::string_view(Large1.data(), Large1.size())));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringSearch, Constexpr) {
+    static_assert(Haystack.find(string_view("three")) == 8);
+    static_assert(Haystack.rfind(string_view("one")) == 18);
+    static_assert(Haystack.find_last_not_of(string_view("one ")) == 15);
+    static_assert(string("abc").contains('b'));
+}
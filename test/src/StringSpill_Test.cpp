@@ -0,0 +1,132 @@
+#include "common.hpp"
+#include <string>
+#include <utility>
+
+// Past what a byte capacity can describe, so these spill into the header.
+static const std::string Long(300, 'L');
+static const std::string Longer(1000, 'M');
+
+static void AssertSpill(const spill_string& s, string_view expected, bool small) {
+    ASSERT_EQ(s.small(), small);
+    ASSERT_EQ(s.size(), expected.size());
+    ASSERT_EQ(string_view(s), expected);
+    ASSERT_EQ(s.c_str()[s.size()], '\0');
+    ASSERT_GE(s.capacity(), s.size());
+}
+
+TEST(StringSpill, Layout) {
+    constexpr auto layout = spill_string::layout_info();
+
+    // The same object as small_string, with a std::size_t size type.
+    static_assert(sizeof(spill_string) == sizeof(small_string) && spill_string::sboc == small_string::sboc);
+    static_assert(layout.layout == string_layout::spill && layout.field_size == 1 && layout.padding == 0);
+    static_assert(layout.size_offset == 22 && layout.capacity_offset == 23);
+    static_assert(std::is_same_v<spill_string::string_view_type, string_view>);
+    static_assert(sizeof(spill_u16string) == 24 && spill_u16string::sboc == 10);
+}
+
+TEST(StringSpill, Construct) {
+    {
+        spill_string s1;
+        spill_string s2(Large1);
+        spill_string s3(string_view(Long.c_str()));
+        spill_string s4(254, 'x');
+        spill_string s5(255, 'y');
+
+        AssertSpill(s1, Empty, true);
+        AssertSpill(s2, Large1, false);
+        AssertSpill(s3, string_view(Long.c_str()), false);
+        AssertSpill(s4, string_view(std::string(254, 'x').c_str()), false);
+        AssertSpill(s5, string_view(std::string(255, 'y').c_str()), false);
+        ASSERT_EQ(s4.capacity(), 254u);
+        ASSERT_EQ(s5.capacity(), 255u);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringSpill, GrowAndShrink) {
+    {
+        spill_string s1;
+        for (std::size_t i = 0; i < Longer.size(); ++i)
+        {
+            s1.insert(s1.size(), 1, 'M');
+            ASSERT_EQ(s1.size(), i + 1);
+        }
+        AssertSpill(s1, string_view(Longer.c_str()), false);
+
+        // Back to a byte capacity, then to the small buffer.
+        s1.erase(200);
+        s1.shrink_to_fit();
+        AssertSpill(s1, string_view(Longer.c_str(), 200), false);
+        ASSERT_EQ(s1.capacity(), 200u);
+        s1.reserve(400);
+        AssertSpill(s1, string_view(Longer.c_str(), 200), false);
+        ASSERT_EQ(s1.capacity(), 400u);
+        s1.erase(5, spill_string::npos, erase_policy::shrink_to_small);
+        AssertSpill(s1, "MMMMM", true);
+    }
+    {
+        spill_string s1("a-b-c");
+        s1.reserve(300);
+        ASSERT_EQ(s1.replace_all("-", string_view(Long.c_str())), 2u);
+        ASSERT_EQ(s1.size(), 603u);
+        ASSERT_EQ(s1.replace_all(string_view(Long.c_str()), "+"), 2u);
+        AssertSpill(s1, "a+b+c", false);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringSpill, CopyAndMove) {
+    {
+        spill_string s1(string_view(Long.c_str()));
+        spill_string s2(s1);
+        spill_string s3(std::move(s1));
+
+        AssertSpill(s1, Empty, true);
+        AssertSpill(s2, string_view(Long.c_str()), false);
+        AssertSpill(s3, string_view(Long.c_str()), false);
+
+        spill_string s4(Large1);
+        s4 = s3;
+        AssertSpill(s4, string_view(Long.c_str()), false);
+        s4 = string_view(Longer.c_str());
+        AssertSpill(s4, string_view(Longer.c_str()), false);
+        s2 = std::move(s4);
+        AssertSpill(s2, string_view(Longer.c_str()), false);
+        AssertSpill(s4, Empty, true);
+        s2 = Small1;
+        AssertSpill(s2, Small1, false);
+        ASSERT_GE(s2.capacity(), Longer.size());
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringSpill, Swap) {
+    {
+        spill_string s1(Small1);
+        spill_string s2(Large1);
+        spill_string s3(string_view(Long.c_str()));
+
+        s1.swap(s3);
+        AssertSpill(s1, string_view(Long.c_str()), false);
+        AssertSpill(s3, Small1, true);
+        s1.swap(s2);
+        AssertSpill(s1, Large1, false);
+        AssertSpill(s2, string_view(Long.c_str()), false);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringSpill, Constexpr) {
+    using constexpr_string = basic_string<char, std::size_t, 15, std::char_traits<char>, std::allocator<char>, string_layout::spill>;
+
+    // The header is written and read at compile time too.
+    static_assert([]
+    {
+        constexpr_string s1(300, 'x');
+        s1.insert(0, "ab");
+        constexpr_string s2(s1);
+        s2.erase(2, constexpr_string::npos, erase_policy::shrink_to_small);
+        return s1.size() == 302 && s1.capacity() >= 302 && s2 == string_view("ab") && s2.small();
+    }());
+}
@@ -0,0 +1,89 @@
+#include "common.hpp"
+#include "string_split.hpp"
+#include <vector>
+
+template <typename _range_t>
+static auto Collect(const _range_t& range)
+{
+    std::vector<std::ranges::range_value_t<_range_t>> elements;
+    for (auto element : range)
+        elements.push_back(element);
+    return elements;
+}
+
+static_assert(std::ranges::forward_range<basic_line_view<char, std::size_t, std::char_traits<char>>>);
+
+TEST(StringSplit, Lines) {
+    ASSERT_EQ(Collect(lines(string_view("a\nbc\r\n\nd"))), (std::vector<string_view>{ "a", "bc", "", "d" }));
+    ASSERT_EQ(Collect(lines(string_view("a\n"))), (std::vector<string_view>{ "a" }));
+    ASSERT_EQ(Collect(lines(string_view("\n\n"))), (std::vector<string_view>{ "", "" }));
+    ASSERT_EQ(Collect(lines(string_view("\r"))), (std::vector<string_view>{ "\r" }));
+    ASSERT_TRUE(lines(Empty).empty());
+}
+
+TEST(StringSplit, Lines_String) {
+    {
+        u16string s1(u"first\nsecond line");
+
+        ASSERT_EQ(Collect(lines(s1)), (std::vector<u16string_view>{ u"first", u"second line" }));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringSplit, Constexpr) {
+    static_assert(std::ranges::distance(lines(string_view("a\nb\nc\n"))) == 3);
+}
+
+static_assert(std::ranges::forward_range<decltype(split(string_view(), ','))>);
+
+TEST(StringSplit, Split) {
+    ASSERT_EQ(Collect(split(string_view("a,bc,,d"), ',')), (std::vector<string_view>{ "a", "bc", "", "d" }));
+    ASSERT_EQ(Collect(split(string_view(",a,"), ',')), (std::vector<string_view>{ "", "a", "" }));
+    ASSERT_EQ(Collect(split(string_view("abc"), ',')), (std::vector<string_view>{ "abc" }));
+    ASSERT_TRUE(split(Empty, ',').empty());
+}
+
+TEST(StringSplit, Split_Sequence) {
+    ASSERT_EQ(Collect(split(string_view("a::b:c::"), "::")), (std::vector<string_view>{ "a", "b:c", "" }));
+    ASSERT_EQ(Collect(split(string_view("abc"), "")), (std::vector<string_view>{ "abc" }));
+}
+
+TEST(StringSplit, SplitAny) {
+    ASSERT_EQ(Collect(split_any(string_view("key=value&flag&x=1"), "=&")), (std::vector<string_view>{ "key", "value", "flag", "x", "1" }));
+    // Long enough to be searched a block at a time, with the delimiters in different lanes.
+    ASSERT_EQ(Collect(split_any(string_view("0123456789abcdef;0123456789\t0123456789abcdefghij"), ";\t")),
+        (std::vector<string_view>{ "0123456789abcdef", "0123456789", "0123456789abcdefghij" }));
+    ASSERT_EQ(Collect(split_any(u32string_view(U"one two\tthree four five six"), U" \t")),
+        (std::vector<u32string_view>{ U"one", U"two", U"three", U"four", U"five", U"six" }));
+}
+
+TEST(StringSplit, Split_String) {
+    {
+        string s1("first,second,a much longer third field");
+
+        ASSERT_EQ(Collect(split(s1, ',')), (std::vector<string_view>{ "first", "second", "a much longer third field" }));
+        ASSERT_EQ(Collect(split_any(s1, ", ")), (std::vector<string_view>{ "first", "second", "a", "much", "longer", "third", "field" }));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringSplit, Split_Bulk) {
+    string_view pieces[4];
+
+    ASSERT_EQ(split(string_view("1,22,,4444"), ',', pieces), 4u);
+    ASSERT_EQ((std::vector<string_view>(pieces, pieces + 4)), (std::vector<string_view>{ "1", "22", "", "4444" }));
+
+    // The last piece keeps the rest.
+    ASSERT_EQ(split(string_view("a;b;c;d;e"), ";", pieces), 4u);
+    ASSERT_EQ(pieces[3], string_view("d;e"));
+
+    ASSERT_EQ(split_any(string_view("a b\tc"), " \t", pieces), 3u);
+    ASSERT_EQ(pieces[2], string_view("c"));
+
+    ASSERT_EQ(split(Empty, ',', pieces), 0u);
+}
+
+TEST(StringSplit, Split_Constexpr) {
+    static_assert(std::ranges::distance(split(string_view("a,b,c,"), ',')) == 4);
+    static_assert(std::ranges::distance(split_any(string_view("a b,c"), " ,")) == 3);
+}
@@ -0,0 +1,71 @@
+#include "common.hpp"
+#include "string_static_map.hpp"
+#include <string>
+
+enum class Method { Unknown, Get, Head, Post, Put, Delete, Connect, Options, Trace, Patch };
+
+static constexpr auto Methods = make_static_string_map<Method>({
+    { "GET", Method::Get },
+    { "HEAD", Method::Head },
+    { "POST", Method::Post },
+    { "PUT", Method::Put },
+    { "DELETE", Method::Delete },
+    { "CONNECT", Method::Connect },
+    { "OPTIONS", Method::Options },
+    { "TRACE", Method::Trace },
+    { "PATCH", Method::Patch },
+});
+
+static constexpr string_view HeaderNames[] = {
+    "accept", "accept-charset", "accept-encoding", "accept-language", "accept-ranges", "age", "allow", "authorization",
+    "cache-control", "connection", "content-disposition", "content-encoding", "content-language", "content-length",
+    "content-location", "content-range", "content-type", "cookie", "date", "etag", "expect", "expires", "from", "host",
+    "if-match", "if-modified-since", "if-none-match", "if-range", "if-unmodified-since", "last-modified", "link",
+    "location", "max-forwards", "proxy-authenticate", "proxy-authorization", "range", "referer", "refresh", "retry-after",
+    "server", "set-cookie", "strict-transport-security", "transfer-encoding", "user-agent", "vary", "via", "www-authenticate",
+};
+
+static constexpr auto Headers = []
+{
+    std::pair<string_view, std::size_t> entries[std::size(HeaderNames)];
+    for (std::size_t i = 0; i < std::size(HeaderNames); ++i)
+        entries[i] = { HeaderNames[i], i };
+    return make_static_string_map<std::size_t>(entries);
+}();
+
+TEST(StringStaticMap, Find) {
+    static_assert(Methods.size() == 9);
+    static_assert(*Methods.find("GET") == Method::Get);
+    static_assert(Methods.value_or("PATCH", Method::Unknown) == Method::Patch);
+    static_assert(!Methods.contains("get"));
+
+    // Keys from runtime storage hash the same as at compile time.
+    for (auto& [key, value] : Methods)
+    {
+        std::string copy(key.data(), key.size());
+        ASSERT_EQ(Methods.value_or(string_view(copy.c_str()), Method::Unknown), value);
+    }
+    ASSERT_EQ(Methods.find("GETS"), nullptr);
+    ASSERT_EQ(Methods.find("GE"), nullptr);
+    ASSERT_EQ(Methods.find(Empty), nullptr);
+}
+
+TEST(StringStaticMap, Find_Many) {
+    for (std::size_t i = 0; i < std::size(HeaderNames); ++i)
+    {
+        std::string copy(HeaderNames[i].data(), HeaderNames[i].size());
+        const std::size_t* index = Headers.find(string_view(copy.c_str()));
+        ASSERT_NE(index, nullptr);
+        ASSERT_EQ(*index, i);
+
+        copy += '!';
+        ASSERT_FALSE(Headers.contains(string_view(copy.c_str())));
+    }
+}
+
+TEST(StringStaticMap, OtherCharTypes) {
+    static constexpr auto Map = make_static_string_map<int, char16_t>({ { u"one", 1 }, { u"two", 2 }, { u"three", 3 } });
+
+    static_assert(Map.value_or(u"three", 0) == 3);
+    static_assert(!Map.contains(u"four"));
+}
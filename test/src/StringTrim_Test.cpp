@@ -0,0 +1,88 @@
+#include "common.hpp"
+#include <string>
+#include <string_view>
+
+TEST(StringTrim, View) {
+    ASSERT_EQ(string_view("  \t hello world \r\n").trim(), string_view("hello world"));
+    ASSERT_EQ(string_view("  \t hello world \r\n").trim_left(), string_view("hello world \r\n"));
+    ASSERT_EQ(string_view("  \t hello world \r\n").trim_right(), string_view("  \t hello world"));
+    ASSERT_EQ(string_view("xxhixx").trim("x"), string_view("hi"));
+    ASSERT_TRUE(string_view(" \n\v\f ").trim().empty());
+    ASSERT_TRUE(Empty.trim().empty());
+}
+
+TEST(StringTrim, View_Long) {
+    // Fixed-width records padded with long runs, which are skipped a block at a time.
+    std::string record = std::string(45, ' ') + "value" + std::string(70, ' ');
+    string_view view(record.c_str());
+
+    ASSERT_EQ(view.trim(), string_view("value"));
+    ASSERT_EQ(view.trim_left().size(), 75ul);
+    ASSERT_EQ(view.trim_right().size(), 50ul);
+
+    std::u32string wide = std::u32string(37, U'0') + U"42" + std::u32string(9, U'0');
+    ASSERT_EQ(u32string_view(wide.c_str()).trim(U"0"), u32string_view(U"42"));
+}
+
+TEST(StringTrim, View_Constexpr) {
+    static_assert(string_view("  value  ").trim() == string_view("value"));
+    static_assert(string_view("--value").trim_left("-") == string_view("value"));
+}
+
+TEST(StringTrim, FindNotOf_Blocks) {
+    // Compare against the standard library at every position relative to the blocks.
+    for (std::size_t size = 0; size < 70; ++size)
+    {
+        for (std::size_t position = 0; position <= size; ++position)
+        {
+            std::string text(size, ' ');
+            if (position < size)
+                text[position] = 'x';
+            std::string_view expected(text);
+            string_view view(text.data(), text.size());
+
+            ASSERT_EQ(view.find_first_not_of(" \t"), expected.find_first_not_of(" \t"));
+            ASSERT_EQ(view.find_last_not_of(" \t"), expected.find_last_not_of(" \t"));
+            ASSERT_EQ(view.find_first_of("x"), expected.find_first_of("x"));
+            ASSERT_EQ(view.find_last_of("xy"), expected.find_last_of("xy"));
+            ASSERT_EQ(view.find_first_not_of(" ", 3), expected.find_first_not_of(" ", 3));
+            ASSERT_EQ(view.find_last_not_of(" ", 40), expected.find_last_not_of(" ", 40));
+        }
+    }
+}
+
+TEST(StringTrim, String) {
+    {
+        string s1("  \t this is a large string \r\n");
+        s1.trim();
+
+        AssertLarge(s1, Large1);
+    }
+    {
+        string s1("this is a large string\n\n\n\n");
+        const char* data = s1.data();
+        s1.trim_right();
+
+        AssertLarge(s1, Large1);
+        ASSERT_EQ(s1.data(), data);
+    }
+    {
+        string s1("   small");
+        s1.trim_left();
+
+        AssertSmall(s1, Small1);
+    }
+    {
+        string s1("      ");
+        s1.trim();
+
+        AssertEmpty(s1);
+    }
+    {
+        small_string s1("  small  ");
+        s1.trim();
+
+        ASSERT_EQ(small_string::string_view_type(s1), small_string::string_view_type("small"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
@@ -0,0 +1,116 @@
+#include "common.hpp"
+#include "string_graphemes.hpp"
+#include <vector>
+
+template <typename _range_t>
+static auto Collect(const _range_t& range)
+{
+    std::vector<std::ranges::range_value_t<_range_t>> elements;
+    for (auto element : range)
+        elements.push_back(element);
+    return elements;
+}
+
+static_assert(std::ranges::forward_range<basic_code_point_view<char8_t, std::size_t, std::char_traits<char8_t>>>);
+static_assert(std::ranges::forward_range<basic_grapheme_view<char16_t, std::size_t, std::char_traits<char16_t>>>);
+
+TEST(StringUnicodeIteration, CodePoints_Utf8) {
+    u8string_view view = u8"aé€\U0001F600";
+    auto range = code_points(view);
+
+    ASSERT_EQ(Collect(range), (std::vector<char32_t>{ U'a', U'é', U'€', U'\U0001F600' }));
+
+    auto it = range.begin();
+    ASSERT_EQ(it.offset(), 0ul);
+    ++it;
+    ASSERT_EQ(it.offset(), 1ul);
+    ASSERT_EQ(it.units(), view.substr(1, 2));
+    ++it;
+    ++it;
+    ASSERT_EQ(it.offset(), 6ul);
+    ++it;
+    ASSERT_EQ(it, range.end());
+}
+
+TEST(StringUnicodeIteration, CodePoints_Utf16) {
+    char16_t units[] = { u'a', 0xD83D, 0xDE00, 0xDC00, u'b' };
+
+    ASSERT_EQ(Collect(code_points(u16string_view(units, 5))), (std::vector<char32_t>{ U'a', U'\U0001F600', U'�', U'b' }));
+}
+
+TEST(StringUnicodeIteration, CodePoints_AsciiRuns) {
+    {
+        u8string s1(u8"a long run of plain ASCII text, then é, then more ASCII text that spans blocks");
+        std::u32string expected = U"a long run of plain ASCII text, then é, then more ASCII text that spans blocks";
+
+        auto elements = Collect(code_points(s1));
+        ASSERT_EQ(std::u32string(elements.begin(), elements.end()), expected);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringUnicodeIteration, CodePoints_IllFormed) {
+    u8string_view view(reinterpret_cast<const char8_t*>("a\xE2\x82" "b\xFF"), 5);
+
+    ASSERT_EQ(Collect(code_points(view)), (std::vector<char32_t>{ U'a', U'�', U'b', U'�' }));
+}
+
+TEST(StringUnicodeIteration, TruncateCodePoints) {
+    u8string_view view = u8"abcdefghijklmnopqrstuvwxyzé€\U0001F600";
+
+    ASSERT_EQ(truncate_code_points(view, 0), view.substr(0, 0));
+    ASSERT_EQ(truncate_code_points(view, 20), view.substr(0, 20));
+    ASSERT_EQ(truncate_code_points(view, 27), view.substr(0, 28));
+    ASSERT_EQ(truncate_code_points(view, 28), view.substr(0, 31));
+    ASSERT_EQ(truncate_code_points(view, 100), view);
+}
+
+TEST(StringUnicodeIteration, Graphemes_Ascii) {
+    u8string_view view = u8"ab\r\nc\n\rd";
+
+    ASSERT_EQ(Collect(graphemes(view)), (std::vector<u8string_view>{ u8"a", u8"b", u8"\r\n", u8"c", u8"\n", u8"\r", u8"d" }));
+}
+
+TEST(StringUnicodeIteration, Graphemes_Combining) {
+    // Extend, SpacingMark and Prepend.
+    u8string_view view = u8"e\u0301\u0302x\u0915\u093F\u0600a";
+
+    ASSERT_EQ(Collect(graphemes(view)), (std::vector<u8string_view>{ u8"e\u0301\u0302", u8"x", u8"\u0915\u093F", u8"\u0600a" }));
+}
+
+TEST(StringUnicodeIteration, Graphemes_Emoji) {
+    // A ZWJ sequence, a skin tone modifier, and a ZWJ not preceded by a pictograph.
+    u8string_view family = u8"\U0001F468\u200D\U0001F469\u200D\U0001F467";
+    u8string_view wave = u8"\U0001F44B\U0001F3FD";
+    u8string_view view = u8"\U0001F468\u200D\U0001F469\u200D\U0001F467\U0001F44B\U0001F3FDa\u200D\U0001F600";
+
+    ASSERT_EQ(Collect(graphemes(view)), (std::vector<u8string_view>{ family, wave, u8"a\u200D", u8"\U0001F600" }));
+}
+
+TEST(StringUnicodeIteration, Graphemes_RegionalIndicators) {
+    // Flags pair up, leaving the odd one out on its own.
+    u16string_view view = u"\U0001F1FA\U0001F1F8\U0001F1EF\U0001F1F5\U0001F1EB";
+
+    ASSERT_EQ(Collect(graphemes(view)), (std::vector<u16string_view>{ u"\U0001F1FA\U0001F1F8", u"\U0001F1EF\U0001F1F5", u"\U0001F1EB" }));
+}
+
+TEST(StringUnicodeIteration, Graphemes_Hangul) {
+    // L V T jamo, an LV syllable with a T, an LVT syllable, then a lone V.
+    u8string_view view = u8"\u1100\u1161\u11A8\uAC00\u11A8\uAC01\u1161";
+
+    ASSERT_EQ(Collect(graphemes(view)), (std::vector<u8string_view>{ u8"\u1100\u1161\u11A8", u8"\uAC00\u11A8", u8"\uAC01", u8"\u1161" }));
+}
+
+TEST(StringUnicodeIteration, TruncateGraphemes) {
+    u8string_view view = u8"ne\u0301e\u0301 \U0001F1FA\U0001F1F8 plus a tail";
+
+    ASSERT_EQ(truncate_graphemes(view, 2), u8string_view(u8"ne\u0301"));
+    ASSERT_EQ(truncate_graphemes(view, 5), u8string_view(u8"ne\u0301e\u0301 \U0001F1FA\U0001F1F8"));
+    ASSERT_EQ(truncate_graphemes(view, 1000), view);
+}
+
+TEST(StringUnicodeIteration, Constexpr) {
+    static_assert(*++code_points(u8string_view(u8"a\U0001F600")).begin() == U'\U0001F600');
+    static_assert(std::ranges::distance(graphemes(u8string_view(u8"e\u0301\r\n"))) == 2);
+    static_assert(truncate_code_points(u8string_view(u8"é€"), 1).size() == 2);
+}
@@ -0,0 +1,133 @@
+#include "common.hpp"
+#include "string_unicode.hpp"
+
+static constexpr u8string_view Utf8 = u8"ASCII, café, €, \U0001F600 and \U0010FFFF, long enough to use a vector block or two.";
+static constexpr u16string_view Utf16 = u"ASCII, café, €, \U0001F600 and \U0010FFFF, long enough to use a vector block or two.";
+static constexpr u32string_view Utf32 = U"ASCII, café, €, \U0001F600 and \U0010FFFF, long enough to use a vector block or two.";
+
+template <typename _string_t>
+static typename _string_t::string_view_type View(const _string_t& string) { return string; }
+
+TEST(StringUnicodeTranscoding, Lengths) {
+    ASSERT_EQ(utf8_length(Utf16), Utf8.size());
+    ASSERT_EQ(utf8_length(Utf32), Utf8.size());
+    ASSERT_EQ(utf16_length(Utf8), Utf16.size());
+    ASSERT_EQ(utf16_length(Utf32), Utf16.size());
+    ASSERT_EQ(utf32_length(Utf8), Utf32.size());
+    ASSERT_EQ(utf32_length(Utf16), Utf32.size());
+    ASSERT_EQ(utf16_length(u8string_view()), 0ul);
+}
+
+TEST(StringUnicodeTranscoding, AllEncodings) {
+    {
+        ASSERT_EQ(View(to_utf8(Utf16)), Utf8);
+        ASSERT_EQ(View(to_utf8(Utf32)), Utf8);
+        ASSERT_EQ(View(to_utf16(Utf8)), Utf16);
+        ASSERT_EQ(View(to_utf16(Utf32)), Utf16);
+        ASSERT_EQ(View(to_utf32(Utf8)), Utf32);
+        ASSERT_EQ(View(to_utf32(Utf16)), Utf32);
+        ASSERT_EQ(View(to_utf32(u8string(Utf8))), Utf32);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringUnicodeTranscoding, SizedOnce) {
+    {
+        u16string s1 = to_utf16(Utf8);
+
+        ASSERT_EQ(s1.capacity(), Utf16.size());
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringUnicodeTranscoding, CharAsUtf8) {
+    {
+        string s1 = to_utf8<string>(Utf32);
+
+        ASSERT_EQ(View(to_utf32(string_view(s1))), Utf32);
+        ASSERT_EQ(View(to_utf16(Large1)), u16string_view(u"this is a large string"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringUnicodeTranscoding, IllFormed_Replaced) {
+    {
+        // Each maximal subpart of an ill-formed sequence becomes one U+FFFD.
+        u8string_view utf8(reinterpret_cast<const char8_t*>("a\xE2\x82" "b\xF0\x9F\x98\xC0z\xE2"), 10);
+        char16_t utf16[] = { u'a', 0xDC00, u'b', 0xD800, u'c', 0xD800 };
+        char32_t utf32[] = { U'a', 0xD800, 0x110000, U'b' };
+
+        ASSERT_EQ(View(to_utf32(utf8)), u32string_view(U"a�b��z�"));
+        ASSERT_EQ(View(to_utf8(u16string_view(utf16, 6))), u8string_view(u8"a�b�c�"));
+        ASSERT_EQ(View(to_utf16(u32string_view(utf32, 4))), u16string_view(u"a��b"));
+        ASSERT_EQ(utf16_length(utf8), 7ul);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringUnicodeTranscoding, Latin1) {
+    {
+        string_view latin1("caf\xE9 \xA9 plus some padding to fill a block", 40);
+        u8string utf8 = latin1_to_utf8(latin1);
+
+        ASSERT_EQ(View(utf8), u8string_view(u8"café © plus some padding to fill a block"));
+        ASSERT_EQ(View(utf8_to_latin1(View(utf8))), latin1);
+        ASSERT_EQ(View(utf8_to_latin1(u8string_view(u8"€ \U0001F600 ÿ"))), string_view("? ? \xFF"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringUnicodeTranscoding, Transcoder_EverySplit) {
+    {
+        for (std::size_t split1 = 0; split1 <= Utf8.size(); ++split1)
+        {
+            for (std::size_t split2 = split1; split2 <= Utf8.size(); split2 += 3)
+            {
+                utf8_to_utf16_transcoder transcoder;
+                u16string s1;
+                transcoder.append(s1, Utf8.substr(0, split1));
+                transcoder.append(s1, Utf8.substr(split1, split2 - split1));
+                transcoder.append(s1, Utf8.substr(split2));
+                ASSERT_FALSE(transcoder.pending());
+                transcoder.finish(s1);
+
+                ASSERT_EQ(View(s1), Utf16);
+            }
+        }
+        for (std::size_t split = 0; split <= Utf16.size(); ++split)
+        {
+            utf16_to_utf8_transcoder transcoder;
+            u8string s1;
+            transcoder.append(s1, Utf16.substr(0, split));
+            transcoder.append(s1, Utf16.substr(split));
+            transcoder.finish(s1);
+
+            ASSERT_EQ(View(s1), Utf8);
+        }
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringUnicodeTranscoding, Transcoder_TruncatedAtEnd) {
+    {
+        utf8_to_utf32_transcoder transcoder;
+        u32string s1;
+        transcoder.append(s1, u8string_view(u8"ok\U0001F600", 4));
+        transcoder.append(s1, u8string_view(u8"\U0001F600" + 2, 1));
+
+        ASSERT_TRUE(transcoder.pending());
+        ASSERT_EQ(View(s1), u32string_view(U"ok"));
+
+        transcoder.finish(s1);
+
+        ASSERT_FALSE(transcoder.pending());
+        ASSERT_EQ(View(s1), u32string_view(U"ok�"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringUnicodeTranscoding, Constexpr) {
+    static_assert(utf16_length(u8string_view(u8"é\U0001F600")) == 3);
+    static_assert(to_utf32(u8string_view(u8"é\U0001F600")).size() == 2);
+    static_assert(to_utf8(u16string_view(u"é\U0001F600"))[0] == char8_t(0xC3));
+}
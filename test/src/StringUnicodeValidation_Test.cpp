@@ -0,0 +1,87 @@
+#include "common.hpp"
+#include "string_unicode.hpp"
+
+// Every category of ill-formed sequence, each paired with its expected error offset.
+static const struct { u8string_view input; std::size_t offset; } IllFormed[] = {
+    { u8string_view(reinterpret_cast<const char8_t*>("\x80"), 1), 0 },             // Lone continuation.
+    { u8string_view(reinterpret_cast<const char8_t*>("a\xC3"), 2), 1 },            // Truncated at end.
+    { u8string_view(reinterpret_cast<const char8_t*>("a\xE2\x82z"), 4), 1 },       // Truncated before ASCII.
+    { u8string_view(reinterpret_cast<const char8_t*>("\xC0\xAF"), 2), 0 },         // Overlong 2 byte.
+    { u8string_view(reinterpret_cast<const char8_t*>("\xE0\x9F\xBF"), 3), 0 },     // Overlong 3 byte.
+    { u8string_view(reinterpret_cast<const char8_t*>("\xF0\x8F\xBF\xBF"), 4), 0 }, // Overlong 4 byte.
+    { u8string_view(reinterpret_cast<const char8_t*>("ab\xED\xA0\x80"), 5), 2 },   // Surrogate.
+    { u8string_view(reinterpret_cast<const char8_t*>("\xF4\x90\x80\x80"), 4), 0 }, // Above U+10FFFF.
+    { u8string_view(reinterpret_cast<const char8_t*>("\xF5\x80\x80\x80"), 4), 0 }, // Invalid lead.
+    { u8string_view(reinterpret_cast<const char8_t*>("\xC3\xA9\xA9"), 3), 2 },     // Too long.
+    { u8string_view(reinterpret_cast<const char8_t*>("\xFF"), 1), 0 },             // Never valid.
+};
+
+TEST(StringUnicodeValidation, Empty) {
+    ASSERT_EQ(validate_utf8(u8string_view()), u8string_view::npos);
+    ASSERT_EQ(validate_utf8(string_view(Empty)), string_view::npos);
+}
+
+TEST(StringUnicodeValidation, WellFormed) {
+    u8string_view view = u8"ASCII, café, €, \U0001F600, �, \U0010FFFF";
+
+    ASSERT_EQ(validate_utf8(view), u8string_view::npos);
+    ASSERT_TRUE(is_valid_utf8(view));
+    ASSERT_TRUE(is_valid_utf8(Large1));
+}
+
+TEST(StringUnicodeValidation, IllFormed) {
+    for (auto [input, offset] : IllFormed)
+    {
+        ASSERT_EQ(validate_utf8(input), offset);
+        ASSERT_FALSE(is_valid_utf8(input));
+    }
+}
+
+TEST(StringUnicodeValidation, IllFormed_AtEveryOffset) {
+    // Spans several blocks so every error lands at every position of, and across, a vector block.
+    const u8string_view filler = u8"é€ab\U0001F600c";
+    for (auto [input, offset] : IllFormed)
+    {
+        for (std::size_t prefix = 0; prefix < 80; ++prefix)
+        {
+            std::u8string buffer;
+            while (buffer.size() < prefix)
+                buffer += buffer.size() + filler.size() <= prefix ? std::u8string(filler.data(), filler.size()) : u8"x";
+            buffer.append(input.data(), input.size());
+            buffer.append(40, u8'y');
+
+            ASSERT_EQ(validate_utf8(u8string_view(buffer.data(), buffer.size())), prefix + offset);
+        }
+    }
+}
+
+TEST(StringUnicodeValidation, WellFormed_Long) {
+    std::u8string buffer;
+    for (int i = 0; i < 100; ++i)
+        buffer += u8"plain ascii run é€\U0001F600";
+
+    ASSERT_EQ(validate_utf8(u8string_view(buffer.data(), buffer.size())), u8string_view::npos);
+}
+
+TEST(StringUnicodeValidation, String) {
+    {
+        u8string s1(u8"café \U0001F600 large enough to allocate");
+        u8string s2(u8string_view(reinterpret_cast<const char8_t*>("bad \xC3"), 5));
+
+        ASSERT_TRUE(is_valid_utf8(s1));
+        ASSERT_EQ(validate_utf8(s2), 4ul);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringUnicodeValidation, SmallSizeType) {
+    small_u8string_view view(reinterpret_cast<const char8_t*>("ok\xE0\x80"), 4);
+
+    ASSERT_EQ(validate_utf8(view), 2);
+    ASSERT_EQ(validate_utf8(small_u8string_view(u8"fine")), small_u8string_view::npos);
+}
+
+TEST(StringUnicodeValidation, Constexpr) {
+    static_assert(validate_utf8(u8string_view(u8"é\U0001F600")) == u8string_view::npos);
+    static_assert(validate_utf8(u8string_view(u8"é\U0001F600", 3)) == 2);
+}
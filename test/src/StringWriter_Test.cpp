@@ -0,0 +1,70 @@
+#include "common.hpp"
+#include "string_writer.hpp"
+#include <string>
+
+static std::string ReadAll(int descriptor)
+{
+    std::string contents;
+    char buffer[256];
+    for (ssize_t count; (count = ::read(descriptor, buffer, sizeof(buffer))) > 0; )
+        contents.append(buffer, static_cast<std::size_t>(count));
+    return contents;
+}
+
+TEST(StringWriter, String) {
+    {
+        string s1("metrics: ");
+        {
+            string_writer writer(s1);
+            writer << "requests=" << 1234 << ' ' << string_view("ratio=") << 0.25 << ' ' << string(Large1);
+        }
+
+        AssertLarge(s1, "metrics: requests=1234 ratio=0.25 this is a large string");
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringWriter, String_OtherCharTypes) {
+    {
+        u16string s1;
+        u16string_writer writer(s1);
+
+        writer << u"x=" << -7 << u'!';
+
+        ASSERT_EQ(u16string_view(s1), u16string_view(u"x=-7!"));
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringWriter, Descriptor) {
+    {
+        int pipe_descriptors[2];
+        ASSERT_EQ(::pipe(pipe_descriptors), 0);
+        std::string expected;
+        {
+            string_writer writer(pipe_descriptors[1], 32);
+            for (int i = 0; i < 20; ++i)
+            {
+                writer << "line " << i << '\n';
+                expected += "line " + std::to_string(i) + '\n';
+            }
+            // Larger than the buffer, so it's written directly.
+            writer << Large1 << Large2;
+            expected += "this is a large stringanother string of largeness";
+        }
+        ::close(pipe_descriptors[1]);
+
+        ASSERT_EQ(ReadAll(pipe_descriptors[0]), expected);
+        ::close(pipe_descriptors[0]);
+    }
+    ASSERT_TRUE(allocation_tracker::query_and_reset());
+}
+
+TEST(StringWriter, Descriptor_Invalid) {
+    string_writer writer(-1, 16);
+
+    writer << Small1;
+    writer.flush();
+
+    ASSERT_EQ(writer.error(), EBADF);
+}
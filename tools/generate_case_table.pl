@@ -0,0 +1,79 @@
+#!/usr/bin/env perl
+# Generates include/string_case_table.hpp from the Unicode Character Database bundled with perl.
+# Usage: perl tools/generate_case_table.pl > include/string_case_table.hpp
+
+use strict;
+use warnings;
+use Unicode::UCD qw(prop_invmap);
+
+# Returns the runs of code points with the same mapping delta, spaced 1 or 2 apart, excluding ASCII.
+sub runs
+{
+    my ($property) = @_;
+    my ($starts, $values, $format) = prop_invmap($property);
+    die "Unexpected format $format for $property" unless $format eq 'a';
+
+    my @deltas;
+    for my $i (0 .. $#$starts)
+    {
+        next if $values->[$i] == 0;
+        my $end = $i < $#$starts ? $starts->[$i + 1] : 0x110000;
+        push @deltas, [$_, $values->[$i] - $starts->[$i]] for $starts->[$i] .. $end - 1;
+    }
+    @deltas = grep { $_->[0] >= 0x80 } @deltas;
+
+    my @runs;
+    for my $delta (@deltas)
+    {
+        my ($code_point, $offset) = @$delta;
+        if (@runs)
+        {
+            my $run = $runs[-1];
+            my $stride = $run->{count} == 1 ? $code_point - $run->{first} : $run->{stride};
+            if ($run->{delta} == $offset && ($stride == 1 || $stride == 2)
+                && $code_point == $run->{first} + $run->{count} * $stride)
+            {
+                $run->{stride} = $stride;
+                ++$run->{count};
+                next;
+            }
+        }
+        push @runs, { first => $code_point, count => 1, stride => 1, delta => $offset };
+    }
+    return @runs;
+}
+
+sub table
+{
+    my ($name, $property, $description) = @_;
+    my @runs = runs($property);
+    print "\n// $description\n";
+    print "inline constexpr _case_run $name\[] =\n{\n";
+    for my $run (@runs)
+    {
+        my $last = $run->{first} + ($run->{count} - 1) * $run->{stride};
+        printf("    { 0x%05X, 0x%05X, %d, %d },\n", $run->{first}, $last, $run->{stride}, $run->{delta});
+    }
+    print "};\n";
+}
+
+my $version = Unicode::UCD::UnicodeVersion();
+print <<"END";
+#pragma once
+
+// Generated by tools/generate_case_table.pl from Unicode $version. Do not edit.
+
+#include <cstdint>
+
+// Code points from `first` to `last`, `stride` apart, map to themselves plus `delta`.
+struct _case_run
+{
+    char32_t first;
+    char32_t last;
+    std::int32_t stride;
+    std::int32_t delta;
+};
+END
+table('_lowercase_table', 'Simple_Lowercase_Mapping', 'Simple_Lowercase_Mapping of non-ASCII code points.');
+table('_uppercase_table', 'Simple_Uppercase_Mapping', 'Simple_Uppercase_Mapping of non-ASCII code points.');
+table('_case_folding_table', 'Simple_Case_Folding', 'Simple_Case_Folding of non-ASCII code points.');
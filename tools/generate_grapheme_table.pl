@@ -0,0 +1,74 @@
+#!/usr/bin/env perl
+# Generates include/string_grapheme_table.hpp from the Unicode Character Database bundled with perl.
+# Usage: perl tools/generate_grapheme_table.pl > include/string_grapheme_table.hpp
+
+use strict;
+use warnings;
+use Unicode::UCD qw(prop_invmap prop_invlist);
+
+# Must match the order of _grapheme_category.
+my @categories = qw(
+    Other CR LF Control Extend ZWJ Regional_Indicator Prepend
+    SpacingMark L V T LV LVT Extended_Pictographic
+);
+my %index = map { $categories[$_] => $_ } 0 .. $#categories;
+
+my @category = (0) x 0x110000;
+my ($starts, $values) = prop_invmap('Grapheme_Cluster_Break');
+for my $i (0 .. $#$starts)
+{
+    my $end = $i < $#$starts ? $starts->[$i + 1] : 0x110000;
+    my $value = $values->[$i];
+    # Perl splits Other by Extended_Pictographic, which is applied below.
+    $value = 'Other' if $value eq 'ExtPict_XX';
+    die "Unknown category $value" unless exists $index{$value};
+    @category[$starts->[$i] .. $end - 1] = ($index{$value}) x ($end - $starts->[$i]);
+}
+
+my @pictographic = prop_invlist('Extended_Pictographic');
+for (my $i = 0; $i < @pictographic; $i += 2)
+{
+    my $end = $i + 1 < @pictographic ? $pictographic[$i + 1] : 0x110000;
+    for my $code_point ($pictographic[$i] .. $end - 1)
+    {
+        die sprintf("U+%04X is pictographic but not Other", $code_point) if $category[$code_point] != 0;
+        $category[$code_point] = $index{Extended_Pictographic};
+    }
+}
+
+# ASCII and the Hangul syllables (LV and LVT) are classified without the table.
+@category[0 .. 0x7F] = (0) x 0x80;
+@category[0xAC00 .. 0xD7A3] = (0) x (0xD7A3 - 0xAC00 + 1);
+
+my @ranges;
+for my $code_point (0 .. 0x10FFFF)
+{
+    push @ranges, ($code_point << 8) | $category[$code_point]
+        if $code_point == 0 || $category[$code_point] != $category[$code_point - 1];
+}
+
+my $version = Unicode::UCD::UnicodeVersion();
+print <<"END";
+#pragma once
+
+// Generated by tools/generate_grapheme_table.pl from Unicode $version. Do not edit.
+
+#include <cstdint>
+
+// Grapheme_Cluster_Break property values, with Extended_Pictographic folded in.
+enum class _grapheme_category : std::uint8_t
+{
+    other, cr, lf, control, extend, zwj, regional_indicator, prepend,
+    spacing_mark, l, v, t, lv, lvt, extended_pictographic,
+};
+
+// Each entry is the first code point of a run, shifted left by 8, or'd with the category of the run.
+inline constexpr std::uint32_t _grapheme_table[] =
+{
+END
+for (my $i = 0; $i < @ranges; $i += 8)
+{
+    my $last = $i + 7 < $#ranges ? $i + 7 : $#ranges;
+    print '    ', join(' ', map { sprintf('0x%08X,', $_) } @ranges[$i .. $last]), "\n";
+}
+print "};\n";
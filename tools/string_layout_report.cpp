@@ -0,0 +1,172 @@
+// Recommends the size type, minimum internal capacity and layout of basic_string<char, ...> for a recorded histogram of string lengths.
+// Every candidate is ranked by the memory its strings would take, counting their heap allocations, then by its object size,
+// and a scan over a vector of strings with the same lengths is timed for each, to show the effect of fitting more per cache line.
+// Usage: g++ -std=c++23 -O2 -I include tools/string_layout_report.cpp -o string_layout_report
+//        ./string_layout_report < histogram.txt
+// Each line of the histogram is a length followed by the number of strings of that length, e.g. "12 40913".
+
+#include "string.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <span>
+#include <utility>
+#include <vector>
+
+struct histogram_entry
+{
+    std::size_t length;
+    std::size_t count;
+};
+
+struct candidate_report
+{
+    const char* size_type;
+    string_layout_info layout;
+    std::size_t heap_strings;
+    double object_bytes;
+    double heap_bytes;
+    double scan_nanoseconds; // Per string.
+
+    double total_bytes() const noexcept { return object_bytes + heap_bytes; }
+};
+
+// The size of the glibc malloc chunk that holds an allocation, including its header.
+static std::size_t malloc_chunk_size(std::size_t bytes) noexcept
+{
+    return std::max<std::size_t>(32, (bytes + 8 + 15) & ~std::size_t(15));
+}
+
+static const char* layout_name(string_layout layout) noexcept
+{
+    return layout == string_layout::packed ? "packed" : layout == string_layout::spill ? "spill" : "standard";
+}
+
+// The most strings to build for timing the scan, sampled with the same distribution as the histogram.
+static constexpr std::size_t sample_limit = std::size_t(1) << 20;
+
+template <typename _string_t>
+static double time_scan(std::span<const std::size_t> sample)
+{
+    std::vector<_string_t> strings;
+    strings.reserve(sample.size());
+    for (std::size_t length : sample)
+        strings.emplace_back(static_cast<typename _string_t::size_type>(length), 'x');
+
+    // Touch every string's first and last character, as a lookup comparing them would.
+    std::size_t checksum = 0;
+    constexpr int passes = 8;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass)
+        for (const _string_t& string : strings)
+            checksum += string.size() + string.front() + string.back();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if (checksum == 0)
+        std::puts(""); // Keep the scan from being optimized out.
+    return elapsed / double(passes * std::max<std::size_t>(strings.size(), 1));
+}
+
+template <typename _size_t, _size_t _min_internal_capacity, string_layout _layout = string_layout::standard>
+static void evaluate(const char* size_type, std::span<const histogram_entry> histogram, std::span<const std::size_t> sample, std::vector<candidate_report>& reports)
+{
+    using string_type = basic_string<char, _size_t, _min_internal_capacity, std::char_traits<char>, std::allocator<char>, _layout>;
+    constexpr string_layout_info layout = string_type::layout_info();
+
+    // Skip minimum internal capacities that round up to the same small buffer as a smaller one.
+    if (!reports.empty() && reports.back().size_type == size_type && reports.back().layout.layout == layout.layout && reports.back().layout.sboc == layout.sboc)
+        return;
+
+    candidate_report report{ size_type, layout, 0, 0, 0, 0 };
+    for (const histogram_entry& entry : histogram)
+    {
+        if (entry.length > layout.max_length)
+            return; // The size type can't describe every string.
+        report.object_bytes += double(entry.count) * double(layout.size);
+        if (entry.length > layout.sboc)
+        {
+            report.heap_strings += entry.count;
+            // A spilled string's size and capacity move into a header before its elements.
+            std::size_t header = _layout == string_layout::spill && entry.length > 0xFE ? 2 * sizeof(_size_t) : 0;
+            report.heap_bytes += double(entry.count) * double(malloc_chunk_size(entry.length + 1 + header));
+        }
+    }
+    report.scan_nanoseconds = time_scan<string_type>(sample);
+    reports.push_back(report);
+}
+
+template <typename _size_t, string_layout _layout = string_layout::standard, std::size_t... _min_internal_capacities>
+static void evaluate_all(const char* size_type, std::span<const histogram_entry> histogram, std::span<const std::size_t> sample, std::vector<candidate_report>& reports, std::index_sequence<_min_internal_capacities...>)
+{
+    (evaluate<_size_t, static_cast<_size_t>(_min_internal_capacities * 8), _layout>(size_type, histogram, sample, reports), ...);
+}
+
+int main()
+{
+    std::vector<histogram_entry> histogram;
+    std::size_t total = 0;
+    for (histogram_entry entry; std::scanf("%zu %zu", &entry.length, &entry.count) == 2; )
+    {
+        histogram.push_back(entry);
+        total += entry.count;
+    }
+    if (total == 0)
+    {
+        std::fputs("Expected lines of \"length count\" on stdin.\n", stderr);
+        return 1;
+    }
+
+    // Sample the lengths in proportion to their counts, interleaved so the scan isn't sorted by length.
+    std::vector<std::size_t> sample;
+    double scale = std::min(1.0, double(sample_limit) / double(total));
+    for (const histogram_entry& entry : histogram)
+        sample.insert(sample.end(), std::max<std::size_t>(1, std::size_t(double(entry.count) * scale)), entry.length);
+    std::uint64_t random = 0x9E3779B97F4A7C15ull;
+    for (std::size_t i = sample.size(); i > 1; --i)
+    {
+        random ^= random << 13, random ^= random >> 7, random ^= random << 17;
+        std::swap(sample[i - 1], sample[random % i]);
+    }
+
+    std::vector<candidate_report> reports;
+    auto capacities = std::make_index_sequence<9>(); // 0, 8, ..., 64.
+    evaluate_all<std::uint8_t>("std::uint8_t", histogram, sample, reports, capacities);
+    evaluate_all<std::uint16_t>("std::uint16_t", histogram, sample, reports, capacities);
+    evaluate_all<std::uint32_t>("std::uint32_t", histogram, sample, reports, capacities);
+    evaluate_all<std::size_t>("std::size_t", histogram, sample, reports, capacities);
+    // The packed layout's small buffer is as large as it can be, so it has only one candidate per size type.
+    evaluate<std::uint32_t, 0, string_layout::packed>("std::uint32_t", histogram, sample, reports);
+    evaluate<std::size_t, 0, string_layout::packed>("std::size_t", histogram, sample, reports);
+    evaluate_all<std::size_t, string_layout::spill>("std::size_t", histogram, sample, reports, capacities);
+
+    std::stable_sort(reports.begin(), reports.end(), [](const candidate_report& a, const candidate_report& b)
+    {
+        return a.total_bytes() != b.total_bytes() ? a.total_bytes() < b.total_bytes() : a.layout.size < b.layout.size;
+    });
+
+    std::printf("%zu strings, %zu distinct lengths.\n\n", total, histogram.size());
+    std::printf("%-14s %-8s %5s %6s %8s %7s %12s %12s %12s %9s\n", "size type", "layout", "sboc", "sizeof", "per line", "heap %", "object MiB", "heap MiB", "total MiB", "scan ns");
+    for (const candidate_report& report : reports)
+    {
+        std::printf("%-14s %-8s %5zu %6zu %8zu %6.1f%% %12.2f %12.2f %12.2f %9.2f\n",
+            report.size_type, layout_name(report.layout.layout), report.layout.sboc, report.layout.size, report.layout.per_cache_line(),
+            100.0 * double(report.heap_strings) / double(total),
+            report.object_bytes / 1048576.0, report.heap_bytes / 1048576.0, report.total_bytes() / 1048576.0,
+            report.scan_nanoseconds);
+    }
+    if (reports.empty())
+    {
+        std::puts("No size type can describe the longest string.");
+        return 1;
+    }
+
+    const candidate_report& best = reports.front();
+    if (best.layout.layout == string_layout::packed)
+        std::printf("\nRecommended: basic_packed_string<char, %s>, %zu bytes with %zu characters inline.\n",
+            best.size_type, best.layout.size, best.layout.sboc);
+    else if (best.layout.layout == string_layout::spill)
+        std::printf("\nRecommended: basic_string<char, %s, %zu, std::char_traits<char>, std::allocator<char>, string_layout::spill>, %zu bytes with %zu characters inline.\n",
+            best.size_type, best.layout.sboc, best.layout.size, best.layout.sboc);
+    else
+        std::printf("\nRecommended: basic_string<char, %s, %zu>, %zu bytes with %zu characters inline.\n",
+            best.size_type, best.layout.sboc, best.layout.size, best.layout.sboc);
+}
@@ -0,0 +1,84 @@
+// Compares pool_allocator with std::allocator for strings that churn: a table of strings just past the small buffer,
+// 16 to 128 chars, has random entries replaced over and over, freeing one heap buffer and allocating another each time.
+// It runs on one thread, then on several with each thread on its own table, then with the tables passed between
+// threads every round, so most buffers are freed by a different thread than allocated them.
+// Usage: g++ -std=c++23 -O2 -I include tools/string_pool_benchmark.cpp -o string_pool_benchmark
+//        ./string_pool_benchmark [threads, 4 by default]
+
+#include "string.hpp"
+#include "string_pool_allocator.hpp"
+#include <barrier>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+template <typename _allocator_t>
+using churn_string = basic_string<char, std::size_t, 15, std::char_traits<char>, _allocator_t>;
+
+static constexpr std::size_t table_size = 1 << 16;
+static constexpr std::size_t replacements_per_round = 1 << 18;
+static constexpr std::size_t rounds = 16;
+
+// Replaces random entries of the table with new strings.
+template <typename _string_t>
+static void churn(std::vector<_string_t>& table, std::uint64_t& random)
+{
+    for (std::size_t i = 0; i < replacements_per_round; ++i)
+    {
+        random ^= random << 13, random ^= random >> 7, random ^= random << 17;
+        table[random % table_size] = _string_t(16 + (random >> 32) % 113, 'x');
+    }
+}
+
+// Returns the wall time per replacement, over all threads, with `thread_count` threads each churning a table every round.
+// If `handoff` is set, each thread takes the next thread's table every round.
+template <typename _string_t>
+static double run(std::size_t thread_count, bool handoff)
+{
+    std::vector<std::vector<_string_t>> tables(thread_count, std::vector<_string_t>(table_size));
+    std::barrier round_end(static_cast<std::ptrdiff_t>(thread_count));
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&tables, &round_end, t, thread_count, handoff]
+        {
+            std::uint64_t random = 0x9E3779B97F4A7C15ull * (t + 1);
+            for (std::size_t round = 0; round < rounds; ++round)
+            {
+                churn(tables[handoff ? (t + round) % thread_count : t], random);
+                // Wait for every thread to finish the round before tables change hands.
+                if (handoff)
+                    round_end.arrive_and_wait();
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / double(thread_count * rounds * replacements_per_round);
+}
+
+template <typename _string_t>
+static void benchmark(const char* name, std::size_t thread_count)
+{
+    double single = run<_string_t>(1, false);
+    double parallel = run<_string_t>(thread_count, false);
+    double handoff = run<_string_t>(thread_count, true);
+    std::printf("%-20s %12.1f %12.1f %12.1f\n", name, single, parallel, handoff);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t thread_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    if (thread_count == 0)
+        thread_count = 1;
+
+    std::printf("%zu replacements per thread, %zu threads.\n\n", rounds * replacements_per_round, thread_count);
+    std::printf("%-20s %12s %12s %12s\n", "ns per replacement", "1 thread", "own tables", "handoff");
+    benchmark<churn_string<std::allocator<char>>>("std::allocator", thread_count);
+    benchmark<churn_string<pool_allocator<char>>>("pool_allocator", thread_count);
+    benchmark<churn_string<pow2_pool_allocator<char>>>("pow2_pool_allocator", thread_count);
+}
@@ -0,0 +1,104 @@
+// Compares the memory and speed of a table of millions of strings for each size type and layout.
+// small_string is left out, since it can't hold the longest strings.
+// The strings' lengths follow a mix typical of identifiers, keys and short text: most fit in 15 chars, some in 23,
+// and a few run to a couple of hundred. Heap use is counted as glibc malloc chunks, including their headers.
+// Usage: g++ -std=c++23 -O2 -I include tools/string_table_benchmark.cpp -o string_table_benchmark
+//        ./string_table_benchmark [millions of strings, 4 by default]
+
+#include "string.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// The bytes of every malloc chunk the tables' strings have allocated, with the same chunk sizes as string_layout_report.
+static std::size_t heap_bytes = 0;
+
+static std::size_t malloc_chunk_size(std::size_t bytes) noexcept
+{
+    return std::max<std::size_t>(32, (bytes + 8 + 15) & ~std::size_t(15));
+}
+
+template <typename _value_t>
+struct counting_allocator : std::allocator<_value_t>
+{
+    using value_type = _value_t;
+
+    counting_allocator() noexcept = default;
+    template <typename _other_t>
+    counting_allocator(const counting_allocator<_other_t>&) noexcept {}
+
+    _value_t* allocate(std::size_t count)
+    {
+        heap_bytes += malloc_chunk_size(count * sizeof(_value_t));
+        return std::allocator<_value_t>::allocate(count);
+    }
+
+    void deallocate(_value_t* elements, std::size_t count) noexcept
+    {
+        heap_bytes -= malloc_chunk_size(count * sizeof(_value_t));
+        std::allocator<_value_t>::deallocate(elements, count);
+    }
+};
+
+template <typename _size_t, string_layout _layout = string_layout::standard>
+using table_string = basic_string<char, _size_t, 15, std::char_traits<char>, counting_allocator<char>, _layout>;
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename _string_t>
+static void benchmark(const char* name, const std::vector<std::uint8_t>& lengths)
+{
+    using view_type = typename _string_t::string_view_type;
+    heap_bytes = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<_string_t> table;
+    table.reserve(lengths.size());
+    for (std::size_t i = 0; i < lengths.size(); ++i)
+        table.emplace_back(lengths[i], static_cast<char>('a' + i % 26));
+    double build = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    std::size_t checksum = 0;
+    for (const _string_t& string : table)
+        checksum += string.size() + string.front() + string.back();
+    double scan = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    std::sort(table.begin(), table.end(), [](const _string_t& a, const _string_t& b) { return view_type(a) < view_type(b); });
+    double sort = seconds_since(start);
+
+    double object_mib = double(table.size() * sizeof(_string_t)) / 1048576.0;
+    double heap_mib = double(heap_bytes) / 1048576.0;
+    std::printf("%-24s %6zu %5zu %12.1f %10.1f %11.1f %9.1f %8.1f %8.1f%s\n", name, sizeof(_string_t), std::size_t(_string_t::sboc),
+        object_mib, heap_mib, object_mib + heap_mib, build * 1000.0, scan * 1000.0, sort * 1000.0, checksum == 0 ? " " : "");
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t count = std::size_t(argc > 1 ? std::atof(argv[1]) * 1e6 : 4e6);
+
+    std::vector<std::uint8_t> lengths(count);
+    std::uint64_t random = 0x9E3779B97F4A7C15ull;
+    for (std::uint8_t& length : lengths)
+    {
+        random ^= random << 13, random ^= random >> 7, random ^= random << 17;
+        std::uint64_t bucket = random % 100;
+        std::uint64_t spread = random >> 32;
+        // 60% up to 15 chars, 25% up to 23, and 15% up to 200.
+        length = static_cast<std::uint8_t>(bucket < 60 ? 1 + spread % 15 : bucket < 85 ? 16 + spread % 8 : 24 + spread % 177);
+    }
+
+    std::printf("%zu strings.\n\n", count);
+    std::printf("%-24s %6s %5s %12s %10s %11s %9s %8s %8s\n", "type", "sizeof", "sboc", "object MiB", "heap MiB", "total MiB", "build ms", "scan ms", "sort ms");
+    benchmark<table_string<std::size_t>>("string", lengths);
+    benchmark<table_string<std::uint32_t>>("compact_string", lengths);
+    benchmark<table_string<std::size_t, string_layout::packed>>("packed_string", lengths);
+    benchmark<table_string<std::uint32_t, string_layout::packed>>("packed, std::uint32_t", lengths);
+    benchmark<table_string<std::size_t, string_layout::spill>>("spill_string", lengths);
+}